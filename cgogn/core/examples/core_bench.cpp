@@ -0,0 +1,639 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/reordering.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/types/cmap/cmap3.h>
+#include <cgogn/core/types/cmap/dart_marker.h>
+#include <cgogn/core/types/container/attribute_container.h>
+#include <cgogn/core/types/container/chunk_allocator.h>
+#include <cgogn/core/types/container/chunk_array.h>
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <cgogn/io/surface/off.h>
+#include <cgogn/io/volume/tet.h>
+
+#include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/geometry/algos/length.h>
+#include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/algos/reordering.h>
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#define DEFAULT_MESH_PATH CGOGN_STR(CGOGN_DATA_PATH) "/meshes/"
+
+using namespace cgogn;
+
+using Vec3 = geometry::Vec3;
+using Scalar = geometry::Scalar;
+
+// number of allocations made by the program (counted by the replacement of the global operator new below)
+std::atomic<uint64> nb_allocations = 0u;
+
+void* operator new(std::size_t size)
+{
+	++nb_allocations;
+	if (void* p = std::malloc(size == 0u ? 1u : size))
+		return p;
+	throw std::bad_alloc();
+}
+
+// the memory of the replaced operator new comes from malloc, freeing it is not a mismatch
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+// best wall-clock time (in seconds) of nb_runs calls of f
+template <typename FUNC>
+float64 best_time(uint32 nb_runs, const FUNC& f)
+{
+	float64 best = std::numeric_limits<float64>::max();
+	for (uint32 i = 0; i < nb_runs; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<float64> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+////////////////////
+// thread scaling //
+////////////////////
+
+// vertex normals and average filter with 1 to max_nb_threads workers, using the buffered parallel_foreach_cell
+// (library kernels) and the work stealing traversal
+int bench_scaling(const std::vector<std::string>& args)
+{
+	using Mesh = CMap2;
+	using Vertex = Mesh::Vertex;
+
+	std::string filename = args.size() > 0 ? args[0] : std::string(DEFAULT_MESH_PATH) + "off/horse.off";
+	uint32 max_nb_threads = args.size() > 1 ? uint32(std::stoul(args[1])) : thread_pool()->max_nb_workers();
+	uint32 nb_passes = args.size() > 2 ? uint32(std::stoul(args[2])) : 10u;
+
+	if (max_nb_threads > thread_pool()->max_nb_workers())
+	{
+		std::cout << "the thread pool only has " << thread_pool()->max_nb_workers() << " workers" << std::endl;
+		max_nb_threads = thread_pool()->max_nb_workers();
+	}
+
+	Mesh m;
+	if (!io::import_OFF(m, filename))
+	{
+		std::cout << "could not import " << filename << std::endl;
+		return 1;
+	}
+	auto position = get_attribute<Vec3, Vertex>(m, "position");
+	auto normal = add_attribute<Vec3, Vertex>(m, "normal");
+	auto filtered = add_attribute<Vec3, Vertex>(m, "filtered");
+
+	auto normal_work_stealing = [&]() {
+		parallel_foreach_cell_work_stealing(m, [&](Vertex v) -> bool {
+			value<Vec3>(m, normal, v) = geometry::normal(m, v, position.get());
+			return true;
+		});
+	};
+	auto filter_work_stealing = [&]() {
+		parallel_foreach_cell_work_stealing(m, [&](Vertex v) -> bool {
+			Vec3 sum = Vec3::Zero();
+			uint32 count = 0;
+			foreach_adjacent_vertex_through_edge(m, v, [&](Vertex av) -> bool {
+				sum += value<Vec3>(m, position, av);
+				++count;
+				return true;
+			});
+			value<Vec3>(m, filtered, v) = sum / Scalar(count);
+			return true;
+		});
+	};
+
+	std::cout << filename << ": " << nb_cells<Vertex>(m) << " vertices, " << nb_passes << " passes, best of 3"
+			  << std::endl;
+
+	// time, and speedup over the single thread time, of each kernel
+	std::vector<float64> single_thread_times;
+	for (uint32 nb_threads = 1u; nb_threads <= max_nb_threads; ++nb_threads)
+	{
+		thread_pool()->set_nb_workers(nb_threads);
+
+		std::vector<float64> times = {
+			best_time(3, [&]() {
+				for (uint32 i = 0; i < nb_passes; ++i)
+					geometry::compute_normal(m, position.get(), normal.get());
+			}),
+			best_time(3, [&]() {
+				for (uint32 i = 0; i < nb_passes; ++i)
+					normal_work_stealing();
+			}),
+			best_time(3, [&]() {
+				for (uint32 i = 0; i < nb_passes; ++i)
+					geometry::filter_average<Vec3>(m, position.get(), filtered.get());
+			}),
+			best_time(3, [&]() {
+				for (uint32 i = 0; i < nb_passes; ++i)
+					filter_work_stealing();
+			}),
+		};
+		if (nb_threads == 1u)
+			single_thread_times = times;
+
+		const char* names[] = {"normal (buffers)", "normal (work stealing)", "filter (buffers)",
+							   "filter (work stealing)"};
+		for (uint32 i = 0; i < 4u; ++i)
+			std::cout << std::setw(3) << nb_threads << " threads  " << std::left << std::setw(24) << names[i]
+					  << std::right << std::fixed << std::setprecision(3) << times[i] << " s  x"
+					  << std::setprecision(2) << single_thread_times[i] / times[i] << std::endl;
+	}
+	thread_pool()->set_nb_workers();
+
+	return 0;
+}
+
+/////////////////////////
+// container iteration //
+/////////////////////////
+
+// first_index/next_index iteration over a container of nb_indices indices, some of which are released
+int bench_container(const std::vector<std::string>& args)
+{
+	uint32 nb_indices = args.size() > 0 ? uint32(std::stoul(args[0])) : 20000000u;
+
+	struct Fragmentation
+	{
+		std::string name;
+		std::function<bool(uint32)> released;
+	};
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<float64> distribution(0.0, 1.0);
+	std::vector<Fragmentation> fragmentations = {
+		{"dense", [](uint32) { return false; }},
+		{"alternate 50%", [](uint32 i) { return i % 2u == 0u; }},
+		{"random 50%", [&](uint32) { return distribution(generator) < 0.5; }},
+		{"random 90%", [&](uint32) { return distribution(generator) < 0.9; }},
+	};
+
+	std::cout << nb_indices << " indices, best of 5" << std::endl;
+	for (const Fragmentation& fragmentation : fragmentations)
+	{
+		AttributeContainerT<ChunkArray> container;
+		auto attribute = container.add_attribute<uint32>("attribute");
+		for (uint32 i = 0; i < nb_indices; ++i)
+			container.new_index();
+		for (uint32 i = 0; i < nb_indices; ++i)
+		{
+			if (fragmentation.released(i))
+				container.release_index(i);
+		}
+
+		// the sums keep the loops from being optimized away and check that both visit the same indices
+		uint64 next_index_sum = 0u;
+		float64 next_index_time = best_time(5, [&]() {
+			next_index_sum = 0u;
+			for (uint32 i = container.first_index(), end = container.last_index(); i != end;
+				 i = container.next_index(i))
+				next_index_sum += i;
+		});
+		uint64 slots_sum = 0u;
+		float64 slots_time = best_time(5, [&]() {
+			slots_sum = 0u;
+			for (uint32 i = 0, end = container.last_index(); i != end; ++i)
+			{
+				if (container.is_used(i))
+					slots_sum += i;
+			}
+		});
+
+		std::cout << std::left << std::setw(14) << fragmentation.name << std::right << std::fixed
+				  << std::setprecision(1) << "next_index " << next_index_time * 1000.0 << " ms, slot by slot "
+				  << slots_time * 1000.0 << " ms" << (next_index_sum == slots_sum ? "" : " (mismatch)") << std::endl;
+	}
+
+	return 0;
+}
+
+//////////////////////////
+// volume vertex orbits //
+//////////////////////////
+
+// vertex orbit traversal of a CMap3 that marks the visited darts with a DartMarkerStore (reference)
+template <typename FUNC>
+void foreach_dart_of_vertex_marker_store(const CMap3& m, Dart d, const FUNC& f)
+{
+	DartMarkerStore<CMap3> marker(m);
+	const std::vector<Dart>& marked_darts = marker.marked_darts();
+
+	marker.mark(d);
+	for (uint32 i = 0; i < uint32(marked_darts.size()); ++i)
+	{
+		const Dart curr_dart = marked_darts[i];
+		f(curr_dart);
+		const Dart d_1 = phi_1(m, curr_dart);
+		const Dart d2_1 = phi2(m, d_1);
+		const Dart d3_1 = phi3(m, d_1);
+		if (!marker.is_marked(d2_1))
+			marker.mark(d2_1);
+		if (!marker.is_marked(d3_1))
+			marker.mark(d3_1);
+	}
+}
+
+// per-vertex orbit traversals of a volume mesh with foreach_dart_of_orbit and with a DartMarkerStore
+int bench_volume(const std::vector<std::string>& args)
+{
+	using Mesh = CMap3;
+	using Vertex = Mesh::Vertex;
+	using Volume = Mesh::Volume;
+
+	std::string filename = args.size() > 0 ? args[0] : std::string(DEFAULT_MESH_PATH) + "tet/hand.tet";
+
+	Mesh m;
+	if (!io::import_TET(m, filename))
+	{
+		std::cout << "could not import " << filename << std::endl;
+		return 1;
+	}
+	auto nb_vertex_darts = add_attribute<uint32, Vertex>(m, "nb_vertex_darts");
+
+	// the dart counts keep the loops from being optimized away and check that both traversals visit the same darts
+	uint64 nb_darts_orbit = 0u;
+	float64 sequential_orbit = best_time(5, [&]() {
+		nb_darts_orbit = 0u;
+		foreach_cell(m, [&](Vertex v) -> bool {
+			foreach_dart_of_orbit(m, v, [&](Dart) -> bool {
+				++nb_darts_orbit;
+				return true;
+			});
+			return true;
+		});
+	});
+	uint64 nb_darts_marker = 0u;
+	float64 sequential_marker = best_time(5, [&]() {
+		nb_darts_marker = 0u;
+		foreach_cell(m, [&](Vertex v) -> bool {
+			foreach_dart_of_vertex_marker_store(m, v.dart, [&](Dart) { ++nb_darts_marker; });
+			return true;
+		});
+	});
+	float64 parallel_orbit = best_time(5, [&]() {
+		parallel_foreach_cell(m, [&](Vertex v) -> bool {
+			uint32 nb = 0u;
+			foreach_dart_of_orbit(m, v, [&](Dart) -> bool {
+				++nb;
+				return true;
+			});
+			value<uint32>(m, nb_vertex_darts, v) = nb;
+			return true;
+		});
+	});
+	float64 parallel_marker = best_time(5, [&]() {
+		parallel_foreach_cell(m, [&](Vertex v) -> bool {
+			uint32 nb = 0u;
+			foreach_dart_of_vertex_marker_store(m, v.dart, [&](Dart) { ++nb; });
+			value<uint32>(m, nb_vertex_darts, v) = nb;
+			return true;
+		});
+	});
+	uint64 nb_incident_vertices = 0u;
+	float64 volume_vertices = best_time(5, [&]() {
+		nb_incident_vertices = 0u;
+		foreach_cell(m, [&](Volume w) -> bool {
+			foreach_incident_vertex(m, w, [&](Vertex) -> bool {
+				++nb_incident_vertices;
+				return true;
+			});
+			return true;
+		});
+	});
+
+	std::cout << filename << ": " << nb_cells<Vertex>(m) << " vertices, " << nb_cells<Volume>(m)
+			  << " volumes, best of 5" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "vertex orbits, sequential: " << sequential_orbit << " s (marker store " << sequential_marker << " s)"
+			  << (nb_darts_orbit == nb_darts_marker ? "" : " (mismatch)") << std::endl;
+	std::cout << "vertex orbits, parallel:   " << parallel_orbit << " s (marker store " << parallel_marker << " s)"
+			  << std::endl;
+	std::cout << "volume incident vertices:  " << volume_vertices << " s (" << nb_incident_vertices << " vertices)"
+			  << std::endl;
+
+	return 0;
+}
+
+////////////////
+// reordering //
+////////////////
+
+// average filter on a surface mesh in file order, in random order and after its reordering along a Hilbert curve
+// or by reverse Cuthill-McKee
+int bench_reorder(const std::vector<std::string>& args)
+{
+	using Mesh = CMap2;
+	using Vertex = Mesh::Vertex;
+
+	std::string filename = args.size() > 0 ? args[0] : std::string(DEFAULT_MESH_PATH) + "off/horse.off";
+	uint32 nb_passes = args.size() > 1 ? uint32(std::stoul(args[1])) : 10u;
+
+	Mesh m;
+	if (!io::import_OFF(m, filename))
+	{
+		std::cout << "could not import " << filename << std::endl;
+		return 1;
+	}
+	auto position = get_attribute<Vec3, Vertex>(m, "position");
+	auto filtered = add_attribute<Vec3, Vertex>(m, "filtered");
+
+	std::cout << filename << ": " << nb_cells<Vertex>(m) << " vertices, " << nb_passes
+			  << " filter_average passes, best of 3" << std::endl;
+
+	auto filter = [&](const std::string& name) {
+		float64 time = best_time(3, [&]() {
+			for (uint32 i = 0; i < nb_passes; ++i)
+				geometry::filter_average<Vec3>(m, position.get(), filtered.get());
+		});
+		std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(3) << time
+				  << " s" << std::endl;
+	};
+	auto reorder = [&](const std::string& name, const std::function<std::vector<uint32>()>& vertex_order) {
+		std::vector<uint32> order;
+		float64 order_time = best_time(1, [&]() { order = vertex_order(); });
+		float64 reorder_time = best_time(1, [&]() { reorder_cells(m, order); });
+		std::cout << name << " order computed in " << std::fixed << std::setprecision(3) << order_time
+				  << " s, cells reordered in " << reorder_time << " s" << std::endl;
+	};
+
+	filter("file order");
+
+	std::mt19937 generator(1);
+	reorder("random", [&]() {
+		std::vector<uint32> order;
+		foreach_cell(m, [&](Vertex v) -> bool {
+			order.push_back(index_of(m, v));
+			return true;
+		});
+		std::shuffle(order.begin(), order.end(), generator);
+		return order;
+	});
+	filter("random");
+
+	reorder("Hilbert", [&]() { return geometry::hilbert_vertex_order<Vec3>(m, position.get()); });
+	filter("Hilbert");
+
+	reorder("RCM", [&]() { return rcm_vertex_order(m); });
+	filter("RCM");
+
+	return 0;
+}
+
+/////////////////
+// allocations //
+/////////////////
+
+// face normal computed from the vertices of the face gathered in a std::vector (former incident_vertices)
+Vec3 face_normal_vector(const CMap2& m, CMap2::Face f, const CMap2::Attribute<Vec3>* vertex_position)
+{
+	std::vector<CMap2::Vertex> vertices;
+	vertices.reserve(32u);
+	incident_vertices(m, f, vertices);
+	Vec3 n = Vec3::Zero();
+	for (uint32 i = 0, nb = uint32(vertices.size()); i < nb; ++i)
+	{
+		const Vec3& p = value<Vec3>(m, vertex_position, vertices[i]);
+		const Vec3& q = value<Vec3>(m, vertex_position, vertices[(i + 1) % nb]);
+		n[0] += (p[1] - q[1]) * (p[2] + q[2]);
+		n[1] += (p[2] - q[2]) * (p[0] + q[0]);
+		n[2] += (p[0] - q[0]) * (p[1] + q[1]);
+	}
+	n.normalize();
+	return n;
+}
+
+// number of allocations and time of per-cell geometry kernels that gather the incident vertices of each cell
+int bench_allocations(const std::vector<std::string>& args)
+{
+	using Mesh = CMap2;
+	using Vertex = Mesh::Vertex;
+	using Edge = Mesh::Edge;
+	using Face = Mesh::Face;
+
+	std::string filename = args.size() > 0 ? args[0] : std::string(DEFAULT_MESH_PATH) + "off/horse.off";
+	uint32 nb_passes = args.size() > 1 ? uint32(std::stoul(args[1])) : 5u;
+
+	Mesh m;
+	if (!io::import_OFF(m, filename))
+	{
+		std::cout << "could not import " << filename << std::endl;
+		return 1;
+	}
+	auto position = get_attribute<Vec3, Vertex>(m, "position");
+	auto face_normal = add_attribute<Vec3, Face>(m, "normal");
+	auto edge_length = add_attribute<Scalar, Edge>(m, "length");
+
+	std::cout << filename << ": " << nb_cells<Face>(m) << " faces, " << nb_cells<Edge>(m) << " edges, " << nb_passes
+			  << " passes" << std::endl;
+
+	auto measure = [&](const std::string& name, const std::function<void()>& kernel) {
+		const uint64 nb_allocations_before = nb_allocations;
+		auto start = std::chrono::steady_clock::now();
+		for (uint32 i = 0; i < nb_passes; ++i)
+			kernel();
+		std::chrono::duration<float64> elapsed = std::chrono::steady_clock::now() - start;
+		std::cout << std::left << std::setw(40) << name << std::right << std::setw(10)
+				  << nb_allocations - nb_allocations_before << " allocations  " << std::fixed << std::setprecision(3)
+				  << elapsed.count() << " s" << std::endl;
+	};
+
+	measure("face normals, sequential", [&]() {
+		foreach_cell(m, [&](Face f) -> bool {
+			value<Vec3>(m, face_normal, f) = geometry::normal(m, f, position.get());
+			return true;
+		});
+	});
+	measure("face normals, parallel", [&]() {
+		parallel_foreach_cell(m, [&](Face f) -> bool {
+			value<Vec3>(m, face_normal, f) = geometry::normal(m, f, position.get());
+			return true;
+		});
+	});
+	measure("face normals, parallel (std::vector)", [&]() {
+		parallel_foreach_cell(m, [&](Face f) -> bool {
+			value<Vec3>(m, face_normal, f) = face_normal_vector(m, f, position.get());
+			return true;
+		});
+	});
+	measure("edge lengths, parallel", [&]() {
+		parallel_foreach_cell(m, [&](Edge e) -> bool {
+			value<Scalar>(m, edge_length, e) = geometry::length(m, e, position.get());
+			return true;
+		});
+	});
+	measure("edge lengths, parallel (work stealing)", [&]() {
+		parallel_foreach_cell_work_stealing(m, [&](Edge e) -> bool {
+			value<Scalar>(m, edge_length, e) = geometry::length(m, e, position.get());
+			return true;
+		});
+	});
+
+	return 0;
+}
+
+//////////////////////
+// chunk allocation //
+//////////////////////
+
+// bandwidth bound kernels (average filter, float32 conversion of the positions as done for the VBOs) on a surface
+// mesh imported under each chunk allocation policy
+int bench_chunks(const std::vector<std::string>& args)
+{
+	using Mesh = CMap2;
+	using Vertex = Mesh::Vertex;
+
+	std::string filename = args.size() > 0 ? args[0] : std::string(DEFAULT_MESH_PATH) + "off/horse.off";
+	uint32 nb_passes = args.size() > 1 ? uint32(std::stoul(args[1])) : 10u;
+
+	struct Policy
+	{
+		std::string name;
+		ChunkAllocationPolicy policy;
+	};
+	std::vector<Policy> policies(4u);
+	policies[0].name = "heap";
+	policies[1].name = "heap, sequential init";
+	policies[1].policy.parallel_first_touch = false;
+	policies[2].name = "arenas";
+	policies[2].policy.huge_page_arenas = true;
+	policies[3].name = "arenas, interleave";
+	policies[3].policy.huge_page_arenas = true;
+	policies[3].policy.placement = ChunkPlacement::INTERLEAVE;
+
+	std::cout << filename << ", " << nb_passes << " passes, best of 3" << std::endl;
+	const ChunkAllocationPolicy default_policy = chunk_allocation_policy();
+	for (const Policy& policy : policies)
+	{
+		set_chunk_allocation_policy(policy.policy);
+
+		Mesh m;
+		if (!io::import_OFF(m, filename))
+		{
+			std::cout << "could not import " << filename << std::endl;
+			return 1;
+		}
+		auto position = get_attribute<Vec3, Vertex>(m, "position");
+		auto filtered = add_attribute<Vec3, Vertex>(m, "filtered");
+
+		float64 filter_time = best_time(3, [&]() {
+			for (uint32 i = 0; i < nb_passes; ++i)
+				geometry::filter_average<Vec3>(m, position.get(), filtered.get());
+		});
+		std::vector<float32> buffer(3u * position->maximum_index());
+		float64 conversion_time = best_time(3, [&]() {
+			for (uint32 i = 0; i < nb_passes; ++i)
+			{
+				parallel_foreach_cell(m, [&](Vertex v) -> bool {
+					const uint32 index = index_of(m, v);
+					const Vec3& p = value<Vec3>(m, position, v);
+					buffer[3u * index] = float32(p[0]);
+					buffer[3u * index + 1u] = float32(p[1]);
+					buffer[3u * index + 2u] = float32(p[2]);
+					return true;
+				});
+			}
+		});
+
+		const ChunkArenasReport arenas = chunk_arenas_report();
+		std::cout << std::left << std::setw(22) << policy.name << std::right << std::fixed << std::setprecision(3)
+				  << "filter " << filter_time << " s, conversion " << conversion_time << " s, " << arenas.nb_arenas
+				  << " arenas (" << std::setprecision(1) << float64(arenas.arenas_bytes) / 1048576.0 << " MiB)"
+				  << std::endl;
+	}
+	set_chunk_allocation_policy(default_policy);
+
+	return 0;
+}
+
+void usage(const char* program)
+{
+	std::cout << "Usage: " << program << " benchmark [arguments]" << std::endl;
+	std::cout << "  scaling [surface_mesh.off] [max_nb_threads] [nb_passes]" << std::endl;
+	std::cout << "  container [nb_indices]" << std::endl;
+	std::cout << "  volume [volume_mesh.tet]" << std::endl;
+	std::cout << "  reorder [surface_mesh.off] [nb_passes]" << std::endl;
+	std::cout << "  allocations [surface_mesh.off] [nb_passes]" << std::endl;
+	std::cout << "  chunks [surface_mesh.off] [nb_passes]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	thread_start();
+
+	std::string benchmark(argv[1]);
+	std::vector<std::string> args(argv + 2, argv + argc);
+	if (benchmark == "scaling")
+		return bench_scaling(args);
+	if (benchmark == "container")
+		return bench_container(args);
+	if (benchmark == "volume")
+		return bench_volume(args);
+	if (benchmark == "reorder")
+		return bench_reorder(args);
+	if (benchmark == "allocations")
+		return bench_allocations(args);
+	if (benchmark == "chunks")
+		return bench_chunks(args);
+
+	usage(argv[0]);
+	return 1;
+}
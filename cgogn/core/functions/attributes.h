@@ -143,9 +143,8 @@ void foreach_attribute(const CMapBase& m, const FUNC& f)
 				  "Wrong function attribute parameter type");
 	for (const std::shared_ptr<AttributeGen>& a : m.attribute_containers_[CELL::ORBIT])
 	{
-		std::shared_ptr<AttributeT> at = std::dynamic_pointer_cast<AttributeT>(a);
-		if (at)
-			f(at);
+		if (a->template is_of_type<T>())
+			f(std::static_pointer_cast<AttributeT>(a));
 	}
 }
 
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/types/cmap/dart_marker.h>
 #include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/utils/work_stealing.h>
 
 #include <cgogn/core/types/cmap/cmap_info.h>
 #include <cgogn/core/types/cmap/cmap_ops.h>
@@ -181,6 +182,7 @@ inline void init_cells_indexing(CMapBase& m)
 		oss << "__index_" << orbit_name(orbit);
 		m.cells_indices_[orbit] = m.darts_.add_attribute<uint32>(oss.str());
 		m.cells_indices_[orbit]->fill(INVALID_INDEX);
+		m.invalidate_nb_cells();
 	}
 }
 
@@ -217,6 +219,11 @@ auto set_index(MESH& m, CELL c, uint32 index) -> std::enable_if_t<std::is_conver
 // CMapBase //
 //////////////
 
+/**
+ * @brief give an index to each cell of m that has none, using all the workers of the thread pool
+ * Each cell is found from its owner dart (see is_cell_owner) and the cells are numbered in the order of
+ * their owners, so the given indices are the same as the ones of a sequential sweep of the darts.
+ */
 template <typename CELL, typename MESH>
 auto index_cells(MESH& m) -> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>>
 {
@@ -225,21 +232,56 @@ auto index_cells(MESH& m) -> std::enable_if_t<std::is_convertible_v<MESH&, CMapB
 		init_cells_indexing<CELL>(m);
 
 	CMapBase& base = static_cast<CMapBase&>(m);
-	DartMarker dm(m);
-	for (Dart d = base.begin(), end = base.end(); d != end; d = base.next(d))
-	{
-		if (!is_boundary(m, d) && !dm.is_marked(d))
-		{
-			const CELL c(d);
-			foreach_dart_of_orbit(m, c, [&](Dart d) -> bool {
-				dm.mark(d);
-				return true;
-			});
-
-			if (index_of(m, c) == INVALID_INDEX)
-				set_index(m, c, new_index<CELL>(m));
-		}
-	}
+	const auto& indices = *base.cells_indices_[CELL::ORBIT];
+	const uint32 last = base.end().index;
+	// the dart range is processed by blocks of darts whose owner bits do not share any word
+	const uint32 block_size = WORK_STEALING_GRAIN_SIZE;
+	const uint32 nb_blocks = (last + block_size - 1u) / block_size;
+
+	// find the owners of the cells to index and count them per block
+	std::vector<uint64> owners((last + 63u) / 64u, 0u);
+	std::vector<uint32> blocks_offsets(nb_blocks + 1u, 0u);
+	parallel_foreach_range(
+		0u, last,
+		[&](uint32 begin, uint32 end) {
+			for (uint32 b = begin; b < end; b += block_size)
+			{
+				const uint32 block_end = std::min(b + block_size, end);
+				uint32 nb = 0u;
+				for (Dart d = b == 0u ? base.begin() : base.next(Dart(b - 1u)); d.index < block_end; d = base.next(d))
+				{
+					if (indices[d.index] == INVALID_INDEX && is_cell_owner(m, CELL(d)))
+					{
+						owners[d.index / 64u] |= uint64(1) << (d.index % 64u);
+						++nb;
+					}
+				}
+				blocks_offsets[b / block_size + 1u] = nb;
+			}
+		},
+		block_size);
+
+	for (uint32 i = 0u; i < nb_blocks; ++i)
+		blocks_offsets[i + 1u] += blocks_offsets[i];
+
+	const std::vector<uint32> new_indices =
+		base.attribute_containers_[CELL::ORBIT].new_indices(blocks_offsets[nb_blocks]);
+
+	// the i-th owner gets the i-th new index (each index and each dart is written by a single worker)
+	parallel_foreach_range(
+		0u, last,
+		[&](uint32 begin, uint32 end) {
+			for (uint32 b = begin; b < end; b += block_size)
+			{
+				uint32 rank = blocks_offsets[b / block_size];
+				for (uint32 w = b / 64u, w_end = (std::min(b + block_size, end) + 63u) / 64u; w < w_end; ++w)
+				{
+					for (uint64 word = owners[w]; word != 0u; word &= word - 1u)
+						set_index(m, CELL(Dart(w * 64u + count_trailing_zeros(word))), new_indices[rank++]);
+				}
+			}
+		},
+		block_size);
 }
 
 /////////////
@@ -57,6 +57,8 @@ std::string cell_name(const MESH& m)
 
 /*****************************************************************************/
 
+// template <typename CELL, typename MESH>
+// uint32 count_cells(const MESH& m);
 // template <typename CELL, typename MESH>
 // uint32 nb_cells(const MESH& m);
 
@@ -67,7 +69,7 @@ std::string cell_name(const MESH& m)
 /////////////
 
 template <typename CELL, typename MESH>
-uint32 nb_cells(const MESH& m)
+uint32 count_cells(const MESH& m)
 {
 	static_assert(is_in_tuple_v<CELL, typename mesh_traits<MESH>::Cells>, "CELL not supported in this MESH");
 	uint32 result = 0;
@@ -78,6 +80,40 @@ uint32 nb_cells(const MESH& m)
 	return result;
 }
 
+template <typename CELL, typename MESH>
+auto nb_cells(const MESH& m) -> std::enable_if_t<!std::is_base_of_v<CMapBase, MESH>, uint32>
+{
+	return count_cells<CELL>(m);
+}
+
+//////////////
+// CMapBase //
+//////////////
+
+/**
+ * @brief number of cells of type CELL of m
+ * The count is kept by the map: it is only computed by a traversal after topological modifications that do not
+ * maintain it (the mesh_ops do, see CellsCountsUpdate). In parano mode, it is checked against a traversal.
+ */
+template <typename CELL, typename MESH>
+auto nb_cells(const MESH& m) -> std::enable_if_t<std::is_base_of_v<CMapBase, MESH>, uint32>
+{
+	static_assert(is_in_tuple_v<CELL, typename mesh_traits<MESH>::Cells>, "CELL not supported in this MESH");
+	const CMapBase& mb = static_cast<const CMapBase&>(m);
+	const uint32 orbit_bit = 1u << CELL::ORBIT;
+	uint32 result;
+	if (mb.nb_cells_valid_orbits_.load(std::memory_order_acquire) & orbit_bit)
+		result = mb.nb_cells_[CELL::ORBIT].load(std::memory_order_relaxed);
+	else
+	{
+		result = count_cells<CELL>(m);
+		mb.nb_cells_[CELL::ORBIT].store(result, std::memory_order_relaxed);
+		mb.nb_cells_valid_orbits_.fetch_or(orbit_bit, std::memory_order_release);
+	}
+	parano_message_assert(result == count_cells<CELL>(m), "Wrong number of cells kept by the map");
+	return result;
+}
+
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
@@ -45,6 +45,8 @@ namespace cgogn
 
 Graph::Vertex cut_edge(Graph& g, Graph::Edge e, bool set_indices)
 {
+	CellsCountsUpdate counts(g);
+
 	Dart e0 = e.dart;
 	Dart e1 = alpha0(g, e0);
 
@@ -56,6 +58,10 @@ Graph::Vertex cut_edge(Graph& g, Graph::Edge e, bool set_indices)
 	alpha0_sew(g, e0, v0);
 	alpha0_sew(g, e1, v1);
 
+	counts.set_variation<Graph::Vertex>(1);
+	counts.set_variation<Graph::HalfEdge>(2);
+	counts.set_variation<Graph::Edge>(1);
+
 	if (set_indices)
 	{
 		if (is_indexed<Graph::Vertex>(g))
@@ -81,10 +87,16 @@ Graph::Vertex cut_edge(Graph& g, Graph::Edge e, bool set_indices)
 
 CMap1::Vertex cut_edge(CMap1& m, CMap1::Edge e, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart d = add_dart(m);
 	phi1_sew(m, e.dart, d);
 	CMap1::Vertex v(d);
 
+	// CMap1::Edge is the same orbit as CMap1::Vertex
+	counts.set_variation<CMap1::Vertex>(1);
+	counts.set_variation<CMap1::Face>(0);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap1::Vertex>(m))
@@ -103,6 +115,8 @@ CMap1::Vertex cut_edge(CMap1& m, CMap1::Edge e, bool set_indices)
 
 CMap2::Vertex cut_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart d1 = e.dart;
 	Dart d2 = phi2(m, d1);
 	phi2_unsew(m, d1);
@@ -114,6 +128,12 @@ CMap2::Vertex cut_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 	set_boundary(m, nv2.dart, is_boundary(m, d2));
 	CMap2::Vertex v(nv1.dart);
 
+	counts.set_variation<CMap2::Vertex>(1);
+	counts.set_variation<CMap2::HalfEdge>(int32(!is_boundary(m, nv1.dart)) + int32(!is_boundary(m, nv2.dart)));
+	counts.set_variation<CMap2::Edge>(1);
+	counts.set_variation<CMap2::Face>(0);
+	counts.set_variation<CMap2::Volume>(0);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap2::Vertex>(m))
@@ -149,6 +169,8 @@ CMap2::Vertex cut_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 
 CMap3::Vertex cut_edge(CMap3& m, CMap3::Edge e, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart d0 = e.dart;
 	Dart d23 = phi<23>(m, d0);
 
@@ -174,6 +196,24 @@ CMap3::Vertex cut_edge(CMap3& m, CMap3::Edge e, bool set_indices)
 	phi3_sew(m, e.dart, phi1(m, d3));
 	phi3_sew(m, d3, phi1(m, e.dart));
 
+	// the edge is cut in each of its incident volumes
+	int32 nb_volumes = 0;
+	Dart it = e.dart;
+	do
+	{
+		if (!is_boundary(m, it))
+			++nb_volumes;
+		it = phi<23>(m, it);
+	} while (it != e.dart);
+	counts.set_variation<CMap3::Vertex>(1);
+	counts.set_variation<CMap3::Vertex2>(nb_volumes);
+	counts.set_variation<CMap3::HalfEdge>(2 * nb_volumes);
+	counts.set_variation<CMap3::Edge>(1);
+	counts.set_variation<CMap3::Edge2>(nb_volumes);
+	counts.set_variation<CMap3::Face>(0);
+	counts.set_variation<CMap3::Face2>(0);
+	counts.set_variation<CMap3::Volume>(0);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap3::Vertex>(m))
@@ -373,6 +413,18 @@ Graph::Vertex collapse_edge(Graph& g, Graph::Edge e, bool set_indices)
 
 CMap1::Vertex collapse_edge(CMap1& m, CMap1::Edge e, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+	if (!is_boundary(m, e.dart))
+	{
+		counts.set_variation<CMap1::Vertex>(-1);
+		counts.set_variation<CMap1::Face>(phi1(m, e.dart) == e.dart ? -1 : 0);
+	}
+	else
+	{
+		counts.set_variation<CMap1::Vertex>(0);
+		counts.set_variation<CMap1::Face>(0);
+	}
+
 	Dart d = phi_1(m, e.dart);
 	phi1_unsew(m, d);
 	remove_dart(m, e.dart);
@@ -391,6 +443,8 @@ CMap1::Vertex collapse_edge(CMap1& m, CMap1::Edge e, bool set_indices)
 
 CMap2::Vertex collapse_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart dd = e.dart;
 	Dart dd_1 = phi_1(m, dd);
 	Dart dd_12 = phi2(m, dd_1);
@@ -398,11 +452,26 @@ CMap2::Vertex collapse_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 	Dart ee_1 = phi_1(m, ee);
 	Dart ee_12 = phi2(m, ee_1);
 
+	int32 nb_half_edges = -int32(!is_boundary(m, dd)) - int32(!is_boundary(m, ee));
+	int32 nb_edges = -1;
+	int32 nb_faces = 0;
+
 	collapse_edge(static_cast<CMap1&>(m), CMap1::Edge(dd), false);
 	collapse_edge(static_cast<CMap1&>(m), CMap1::Edge(ee), false);
 
+	// the faces that became 2-gons are removed and their two edges merged
+	auto remove_two_gon = [&](Dart d) {
+		nb_edges -= 1;
+		if (!is_boundary(m, d))
+		{
+			nb_half_edges -= 2;
+			nb_faces -= 1;
+		}
+	};
+
 	if (codegree(m, CMap2::Face(dd_1)) == 2u)
 	{
+		remove_two_gon(dd_1);
 		Dart dd1 = phi1(m, dd_1);
 		Dart dd12 = phi2(m, dd1);
 		phi2_unsew(m, dd1);
@@ -413,6 +482,7 @@ CMap2::Vertex collapse_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 
 	if (codegree(m, CMap2::Face(ee_1)) == 2u)
 	{
+		remove_two_gon(ee_1);
 		Dart ee1 = phi1(m, ee_1);
 		Dart ee12 = phi2(m, ee1);
 		phi2_unsew(m, ee1);
@@ -423,6 +493,12 @@ CMap2::Vertex collapse_edge(CMap2& m, CMap2::Edge e, bool set_indices)
 
 	CMap2::Vertex v(dd_12);
 
+	counts.set_variation<CMap2::Vertex>(-1);
+	counts.set_variation<CMap2::HalfEdge>(nb_half_edges);
+	counts.set_variation<CMap2::Edge>(nb_edges);
+	counts.set_variation<CMap2::Face>(nb_faces);
+	counts.set_variation<CMap2::Volume>(0);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap2::Vertex>(m))
@@ -48,6 +48,8 @@ namespace cgogn
 
 CMap1::Face add_face(CMap1& m, uint32 size, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart d = add_dart(m);
 	for (uint32 i = 1u; i < size; ++i)
 	{
@@ -56,6 +58,10 @@ CMap1::Face add_face(CMap1& m, uint32 size, bool set_indices)
 	}
 	CMap1::Face f(d);
 
+	// CMap1::Edge is the same orbit as CMap1::Vertex
+	counts.set_variation<CMap1::Vertex>(int32(size));
+	counts.set_variation<CMap1::Face>(1);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap1::Vertex>(m))
@@ -79,6 +85,13 @@ CMap1::Face add_face(CMap1& m, uint32 size, bool set_indices)
 
 CMap2::Face add_face(CMap2& m, uint32 size, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+	counts.set_variation<CMap2::Vertex>(int32(size));
+	counts.set_variation<CMap2::HalfEdge>(int32(size));
+	counts.set_variation<CMap2::Edge>(int32(size));
+	counts.set_variation<CMap2::Face>(1);
+	counts.set_variation<CMap2::Volume>(1);
+
 	CMap2::Face f = add_face(static_cast<CMap1&>(m), size, false);
 	CMap2::Face b = add_face(static_cast<CMap1&>(m), size, false);
 	Dart it = b.dart;
@@ -121,6 +134,63 @@ CMap2::Face add_face(CMap2& m, uint32 size, bool set_indices)
 	return f;
 }
 
+/////////////
+// TriMap2 //
+/////////////
+
+TriMap2::Face add_face(TriMap2& m, uint32 size, bool set_indices)
+{
+	cgogn_message_assert(size == 3u, "TriMap2: only triangles can be added");
+	unused_parameters(size);
+
+	CellsCountsUpdate counts(m);
+	counts.set_variation<TriMap2::Vertex>(3);
+	counts.set_variation<TriMap2::HalfEdge>(3);
+	counts.set_variation<TriMap2::Edge>(3);
+	counts.set_variation<TriMap2::Face>(1);
+	counts.set_variation<TriMap2::Volume>(1);
+
+	Dart d = add_triangle_darts(m);
+	Dart b = add_triangle_darts(m);
+	for (uint32 i = 0u; i < 3u; ++i)
+	{
+		set_boundary(m, Dart(b.index + i), true);
+		phi2_sew(m, Dart(d.index + i), Dart(b.index + (3u - i) % 3u));
+	}
+	TriMap2::Face f(d);
+
+	if (set_indices)
+	{
+		if (is_indexed<TriMap2::Vertex>(m))
+		{
+			foreach_incident_vertex(m, f, [&](TriMap2::Vertex v) -> bool {
+				set_index(m, v, new_index<TriMap2::Vertex>(m));
+				return true;
+			});
+		}
+		if (is_indexed<TriMap2::HalfEdge>(m))
+		{
+			foreach_incident_edge(m, f, [&](TriMap2::Edge e) -> bool {
+				set_index(m, TriMap2::HalfEdge(e.dart), new_index<TriMap2::HalfEdge>(m));
+				return true;
+			});
+		}
+		if (is_indexed<TriMap2::Edge>(m))
+		{
+			foreach_incident_edge(m, f, [&](TriMap2::Edge e) -> bool {
+				set_index(m, e, new_index<TriMap2::Edge>(m));
+				return true;
+			});
+		}
+		if (is_indexed<TriMap2::Face>(m))
+			set_index(m, f, new_index<TriMap2::Face>(m));
+		if (is_indexed<TriMap2::Volume>(m))
+			set_index(m, TriMap2::Volume(f.dart), new_index<TriMap2::Volume>(m));
+	}
+
+	return f;
+}
+
 /*****************************************************************************/
 
 // template <typename MESH>
@@ -135,6 +205,11 @@ CMap2::Face add_face(CMap2& m, uint32 size, bool set_indices)
 
 void remove_face(CMap1& m, CMap1::Face f, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+	const int32 size = int32(codegree(m, f));
+	counts.set_variation<CMap1::Vertex>(-size);
+	counts.set_variation<CMap1::Face>(-1);
+
 	Dart it = phi1(m, f.dart);
 	while (it != f.dart)
 	{
@@ -166,6 +241,13 @@ void CGOGN_CORE_EXPORT merge_incident_faces(CMap2& m, CMap2::Edge e, bool set_in
 	if (is_incident_to_boundary(m, e))
 		return;
 
+	CellsCountsUpdate counts(m);
+	counts.set_variation<CMap2::Vertex>(0);
+	counts.set_variation<CMap2::HalfEdge>(-2);
+	counts.set_variation<CMap2::Edge>(-1);
+	counts.set_variation<CMap2::Face>(-1);
+	counts.set_variation<CMap2::Volume>(0);
+
 	Dart d0 = e.dart;
 	Dart d1 = phi2(m, d0);
 	Dart d_1 = phi_1(m, d0);
@@ -175,8 +257,9 @@ void CGOGN_CORE_EXPORT merge_incident_faces(CMap2& m, CMap2::Edge e, bool set_in
 
 	if (set_indices)
 	{
+		// the darts of the merged face may still have the index of the other face
 		if (is_indexed<CMap2::Face>(m))
-			copy_index<CMap2::Face>(m, d_1, d0);
+			set_index(m, CMap2::Face(d_1), index_of(m, CMap2::Face(d_1)));
 	}
 
 	remove_face(static_cast<CMap1&>(m), CMap1::Face(d0), set_indices);
@@ -199,6 +282,8 @@ void CGOGN_CORE_EXPORT merge_incident_faces(CMap2& m, CMap2::Edge e, bool set_in
 
 CMap2::Edge cut_face(CMap2& m, CMap2::Vertex v1, CMap2::Vertex v2, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart dd = phi_1(m, v1.dart);
 	Dart ee = phi_1(m, v2.dart);
 	CMap1::Vertex nv1 = cut_edge(static_cast<CMap1&>(m), CMap1::Edge(dd), false);
@@ -209,6 +294,13 @@ CMap2::Edge cut_face(CMap2& m, CMap2::Vertex v1, CMap2::Vertex v2, bool set_indi
 	set_boundary(m, nv2.dart, is_boundary(m, ee));
 	CMap2::Edge e(nv1.dart);
 
+	const int32 nb_faces = int32(!is_boundary(m, dd));
+	counts.set_variation<CMap2::Vertex>(0);
+	counts.set_variation<CMap2::HalfEdge>(2 * nb_faces);
+	counts.set_variation<CMap2::Edge>(nb_faces); // the edge inside a boundary face is not a cell
+	counts.set_variation<CMap2::Face>(nb_faces);
+	counts.set_variation<CMap2::Volume>(0);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap2::Vertex>(m))
@@ -244,6 +336,8 @@ CMap2::Edge cut_face(CMap2& m, CMap2::Vertex v1, CMap2::Vertex v2, bool set_indi
 
 CMap3::Edge cut_face(CMap3& m, CMap3::Vertex v1, CMap3::Vertex v2, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+
 	Dart d = v1.dart;
 	Dart e = v2.dart;
 
@@ -258,6 +352,17 @@ CMap3::Edge cut_face(CMap3& m, CMap3::Vertex v1, CMap3::Vertex v2, bool set_indi
 
 	CMap3::Edge edge(phi_1(m, e));
 
+	// the face is cut on each of its (non boundary) sides
+	const int32 nb_sides = int32(!is_boundary(m, d)) + int32(!is_boundary(m, dd));
+	counts.set_variation<CMap3::Vertex>(0);
+	counts.set_variation<CMap3::Vertex2>(0);
+	counts.set_variation<CMap3::HalfEdge>(2 * nb_sides);
+	counts.set_variation<CMap3::Edge>(1);
+	counts.set_variation<CMap3::Edge2>(nb_sides);
+	counts.set_variation<CMap3::Face>(1);
+	counts.set_variation<CMap3::Face2>(nb_sides);
+	counts.set_variation<CMap3::Volume>(0);
+
 	if (set_indices)
 	{
 		if (is_indexed<CMap3::Vertex>(m))
@@ -444,6 +549,67 @@ CMap2::Face close_hole(CMap2& m, Dart d, bool set_indices)
 	return hole;
 }
 
+/////////////
+// TriMap2 //
+/////////////
+
+TriMap2::Face close_hole(TriMap2& m, Dart d, bool set_indices)
+{
+	cgogn_message_assert(phi2(m, d) == d && !is_boundary(m, d),
+						 "TriMap2: close hole called on a dart that is not a phi2 fix point");
+
+	// the boundary darts have to exist before phi1 of the new face can be computed:
+	// the darts of the hole are gathered first (turning around the hole as for a CMap2)
+	std::vector<Dart> hole_darts = {d};
+	Dart d_next = d;
+	Dart d_phi1;
+	do
+	{
+		do
+		{
+			d_phi1 = phi1(m, d_next);
+			d_next = phi2(m, d_phi1);
+		} while (d_next != d_phi1 && d_phi1 != d);
+
+		if (d_phi1 != d)
+			hole_darts.push_back(d_phi1);
+	} while (d_phi1 != d);
+
+	// the new darts are allocated by triples: the unused darts of the last triple are left as boundary
+	// phi2 fix points, out of any orbit
+	const uint32 nb_darts = uint32(hole_darts.size());
+	std::vector<Dart> boundary_darts;
+	boundary_darts.reserve(nb_darts + 2u);
+	for (uint32 i = 0u; i < nb_darts; i += 3u)
+	{
+		Dart b = add_triangle_darts(m);
+		for (uint32 j = 0u; j < 3u; ++j)
+		{
+			set_boundary(m, Dart(b.index + j), true);
+			boundary_darts.push_back(Dart(b.index + j));
+		}
+	}
+	for (uint32 i = 0u; i < nb_darts; ++i)
+		phi2_sew(m, hole_darts[i], boundary_darts[i]);
+
+	if (set_indices)
+	{
+		for (uint32 i = 0u; i < nb_darts; ++i)
+		{
+			Dart hd = boundary_darts[i];
+			Dart hd2 = hole_darts[i];
+			if (is_indexed<TriMap2::Vertex>(m))
+				copy_index<TriMap2::Vertex>(m, hd, phi1(m, hd2));
+			if (is_indexed<TriMap2::Edge>(m))
+				copy_index<TriMap2::Edge>(m, hd, hd2);
+			if (is_indexed<TriMap2::Volume>(m))
+				copy_index<TriMap2::Volume>(m, hd, hd2);
+		}
+	}
+
+	return TriMap2::Face(boundary_darts[0]);
+}
+
 /*****************************************************************************/
 
 // template <typename MESH>
@@ -479,6 +645,32 @@ uint32 close(CMap2& m, bool set_indices)
 	}
 
 	return nb_holes;
-} // namespace cgogn
+}
+
+/////////////
+// TriMap2 //
+/////////////
+
+uint32 close(TriMap2& m, bool set_indices)
+{
+	uint32 nb_holes = 0u;
+
+	// the unused boundary darts of the triples are also phi2 fix points
+	std::vector<Dart> fix_point_darts;
+	for (Dart d = m.begin(), end = m.end(); d != end; d = m.next(d))
+		if (phi2(m, d) == d && !is_boundary(m, d))
+			fix_point_darts.push_back(d);
+
+	for (Dart d : fix_point_darts)
+	{
+		if (phi2(m, d) == d)
+		{
+			close_hole(m, d, set_indices);
+			++nb_holes;
+		}
+	}
+
+	return nb_holes;
+}
 
 } // namespace cgogn
@@ -51,6 +51,12 @@ CMap1::Face CGOGN_CORE_EXPORT add_face(CMap1& m, uint32 size, bool set_indices =
 
 CMap2::Face CGOGN_CORE_EXPORT add_face(CMap2& m, uint32 size, bool set_indices = true);
 
+/////////////
+// TriMap2 //
+/////////////
+
+TriMap2::Face CGOGN_CORE_EXPORT add_face(TriMap2& m, uint32 size = 3u, bool set_indices = true);
+
 /*****************************************************************************/
 
 // template <typename MESH>
@@ -122,6 +128,13 @@ CPH3::CMAP::Edge CGOGN_CORE_EXPORT cut_face(CPH3& m, CPH3::CMAP::Vertex v1, CPH3
 
 CMap2::Face close_hole(CMap2& m, Dart d, bool set_indices = true);
 
+/////////////
+// TriMap2 //
+/////////////
+
+// the boundary darts are marked as such (phi1 of a TriMap2 depends on it)
+TriMap2::Face close_hole(TriMap2& m, Dart d, bool set_indices = true);
+
 /*****************************************************************************/
 
 // template <typename MESH>
@@ -136,6 +149,12 @@ CMap2::Face close_hole(CMap2& m, Dart d, bool set_indices = true);
 
 uint32 close(CMap2& m, bool set_indices = true);
 
+/////////////
+// TriMap2 //
+/////////////
+
+uint32 close(TriMap2& m, bool set_indices = true);
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_FUNCTIONS_MESH_OPS_FACE_H_
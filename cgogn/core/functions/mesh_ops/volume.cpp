@@ -180,6 +180,17 @@ CMap2::Volume add_prism(CMap2& m, uint32 size, bool set_indices)
 
 CMap3::Face cut_volume(CMap3& m, const std::vector<Dart>& path, bool set_indices)
 {
+	CellsCountsUpdate counts(m);
+	const int32 size = int32(path.size());
+	counts.set_variation<CMap3::Vertex>(0);
+	counts.set_variation<CMap3::Vertex2>(size);
+	counts.set_variation<CMap3::HalfEdge>(2 * size);
+	counts.set_variation<CMap3::Edge>(0);
+	counts.set_variation<CMap3::Edge2>(size);
+	counts.set_variation<CMap3::Face>(1);
+	counts.set_variation<CMap3::Face2>(2);
+	counts.set_variation<CMap3::Volume>(1);
+
 	Dart f0 = add_face(static_cast<CMap1&>(m), uint32(path.size()), false).dart;
 	Dart f1 = add_face(static_cast<CMap1&>(m), uint32(path.size()), false).dart;
 
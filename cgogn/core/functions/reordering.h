@@ -0,0 +1,310 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_CORE_FUNCTIONS_REORDERING_H_
+#define CGOGN_CORE_FUNCTIONS_REORDERING_H_
+
+#include <cgogn/core/types/mesh_traits.h>
+
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/utils/work_stealing.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace cgogn
+{
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// std::vector<uint32> rcm_vertex_order(const MESH& m);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+/**
+ * @brief compute an order of the vertices by the reverse Cuthill-McKee algorithm on the edges graph
+ * Each connected component is numbered by a breadth-first traversal starting from a pseudo-peripheral vertex,
+ * neighbors being visited by increasing degree. This keeps adjacent vertices close in the order.
+ * @return the vertices indices in their new order (to be given to reorder_cells)
+ */
+template <typename MESH>
+auto rcm_vertex_order(const MESH& m)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>, std::vector<uint32>>
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+
+	if (!is_indexed<Vertex>(m))
+		index_cells<Vertex>(const_cast<MESH&>(m));
+
+	// adjacency of the vertices (positions in vertices_indices) in compressed rows
+	std::vector<uint32> vertices_indices;
+	std::vector<uint32> position(maximum_index<Vertex>(m), INVALID_INDEX);
+	std::vector<uint32> offsets(1u, 0u);
+	std::vector<uint32> neighbors;
+	foreach_cell(m, [&](Vertex v) -> bool {
+		position[index_of(m, v)] = uint32(vertices_indices.size());
+		vertices_indices.push_back(index_of(m, v));
+		foreach_adjacent_vertex_through_edge(m, v, [&](Vertex av) -> bool {
+			neighbors.push_back(index_of(m, av));
+			return true;
+		});
+		offsets.push_back(uint32(neighbors.size()));
+		return true;
+	});
+	for (uint32& n : neighbors)
+		n = position[n];
+
+	const uint32 nb_vertices = uint32(vertices_indices.size());
+	auto degree = [&](uint32 v) -> uint32 { return offsets[v + 1u] - offsets[v]; };
+
+	// breadth-first traversal from v, returns the visited vertices sorted by level and the number of levels
+	std::vector<uint32> level(nb_vertices, INVALID_INDEX);
+	std::vector<uint32> component;
+	auto level_structure = [&](uint32 v) -> uint32 {
+		for (uint32 u : component)
+			level[u] = INVALID_INDEX;
+		component.clear();
+		component.push_back(v);
+		level[v] = 0u;
+		for (uint32 i = 0u; i < uint32(component.size()); ++i)
+		{
+			const uint32 u = component[i];
+			for (uint32 k = offsets[u]; k < offsets[u + 1u]; ++k)
+			{
+				if (level[neighbors[k]] == INVALID_INDEX)
+				{
+					level[neighbors[k]] = level[u] + 1u;
+					component.push_back(neighbors[k]);
+				}
+			}
+		}
+		return level[component.back()] + 1u;
+	};
+
+	// components are started from their vertex of minimal degree
+	std::vector<uint32> by_degree(nb_vertices);
+	for (uint32 v = 0u; v < nb_vertices; ++v)
+		by_degree[v] = v;
+	std::stable_sort(by_degree.begin(), by_degree.end(),
+					 [&](uint32 a, uint32 b) -> bool { return degree(a) < degree(b); });
+
+	std::vector<uint32> order;
+	order.reserve(nb_vertices);
+	std::vector<bool> visited(nb_vertices, false);
+	std::vector<uint32> unvisited_neighbors;
+	for (uint32 start : by_degree)
+	{
+		if (visited[start])
+			continue;
+
+		// pseudo-peripheral vertex: move to the minimal degree vertex of the last level while the depth increases
+		uint32 depth = level_structure(start);
+		while (true)
+		{
+			uint32 candidate = component.back();
+			for (auto it = component.rbegin(); it != component.rend() && level[*it] == depth - 1u; ++it)
+			{
+				if (degree(*it) < degree(candidate))
+					candidate = *it;
+			}
+			const uint32 candidate_depth = level_structure(candidate);
+			if (candidate_depth <= depth)
+				break;
+			start = candidate;
+			depth = candidate_depth;
+		}
+		for (uint32 u : component)
+			level[u] = INVALID_INDEX;
+		component.clear();
+
+		// Cuthill-McKee traversal of the component
+		const uint32 first = uint32(order.size());
+		order.push_back(start);
+		visited[start] = true;
+		for (uint32 i = first; i < uint32(order.size()); ++i)
+		{
+			const uint32 u = order[i];
+			unvisited_neighbors.clear();
+			for (uint32 k = offsets[u]; k < offsets[u + 1u]; ++k)
+			{
+				if (!visited[neighbors[k]])
+				{
+					visited[neighbors[k]] = true;
+					unvisited_neighbors.push_back(neighbors[k]);
+				}
+			}
+			std::stable_sort(unvisited_neighbors.begin(), unvisited_neighbors.end(),
+							 [&](uint32 a, uint32 b) -> bool { return degree(a) < degree(b); });
+			order.insert(order.end(), unvisited_neighbors.begin(), unvisited_neighbors.end());
+		}
+	}
+
+	std::vector<uint32> vertex_order(nb_vertices);
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+		vertex_order[i] = vertices_indices[order[nb_vertices - 1u - i]];
+	return vertex_order;
+}
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// CMapBase::CompactMapping reorder_cells(MESH& m, const std::vector<uint32>& vertex_order);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+/**
+ * @brief renumber the darts and the indexed cells of m following the given order of the vertices
+ * (e.g. computed by rcm_vertex_order or geometry::hilbert_vertex_order), to improve the memory locality of
+ * the traversals: the darts are grouped by vertex and the cells of the other orbits are numbered in the order of
+ * their first dart. The mesh is compacted in the process.
+ * The darts of a TriMap2 are moved by whole triples (grouped by the first of their vertices in the order).
+ * @param vertex_order the used vertices indices in their new order (the used vertices it misses are put last)
+ * @return the old-to-new mapping of the darts and cells indices (see CMapBase::reorder)
+ */
+template <typename MESH>
+auto reorder_cells(MESH& m, const std::vector<uint32>& vertex_order)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>, CMapBase::CompactMapping>
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	cgogn_message_assert(is_indexed<Vertex>(m), "Vertices must be indexed to be reordered");
+
+	CMapBase& base = static_cast<CMapBase&>(m);
+	const auto& vertex_indices = *base.cells_indices_[Vertex::ORBIT];
+	const auto& vertex_container = base.attribute_containers_[Vertex::ORBIT];
+
+	// the order is completed: unused or repeated indices are skipped and the used vertices it misses are put last
+	std::vector<uint32> full_vertex_order;
+	full_vertex_order.reserve(vertex_container.nb_elements());
+	std::vector<bool> vertex_ordered(vertex_container.maximum_index(), false);
+	for (uint32 index : vertex_order)
+	{
+		if (vertex_container.is_used(index) && !vertex_ordered[index])
+		{
+			vertex_ordered[index] = true;
+			full_vertex_order.push_back(index);
+		}
+	}
+	for (uint32 index = vertex_container.first_index(), end = vertex_container.last_index(); index != end;
+		 index = vertex_container.next_index(index))
+	{
+		if (!vertex_ordered[index])
+			full_vertex_order.push_back(index);
+	}
+	const uint32 nb_vertices = uint32(full_vertex_order.size());
+
+	std::vector<uint32> vertex_rank(maximum_index<Vertex>(m), INVALID_INDEX);
+	parallel_foreach_range(0u, nb_vertices, [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+			vertex_rank[full_vertex_order[i]] = i;
+	});
+	// darts without vertex index (if any) are put last
+	auto dart_rank = [&](uint32 d) -> uint32 {
+		const uint32 index = vertex_indices[d];
+		return index == INVALID_INDEX ? nb_vertices : vertex_rank[index];
+	};
+
+	std::vector<uint32> offsets(nb_vertices + 2u, 0u);
+	std::vector<uint32> darts_order(base.darts_.nb_elements());
+	if constexpr (std::is_convertible_v<MESH&, TriMap2&>)
+	{
+		// the darts triples of a TriMap2 cannot be split: they are grouped by their first vertex in the order
+		auto triple_rank = [&](uint32 d) -> uint32 {
+			return std::min(dart_rank(d), std::min(dart_rank(d + 1u), dart_rank(d + 2u)));
+		};
+		for (Dart d = base.begin(), end = base.end(); d != end; d = base.next(d))
+		{
+			if (d.index % 3u == 0u)
+				++offsets[triple_rank(d.index) + 1u];
+		}
+		for (uint32 i = 0u; i <= nb_vertices; ++i)
+			offsets[i + 1u] += offsets[i];
+		for (Dart d = base.begin(), end = base.end(); d != end; d = base.next(d))
+		{
+			if (d.index % 3u == 0u)
+			{
+				const uint32 position = 3u * offsets[triple_rank(d.index)]++;
+				for (uint32 i = 0u; i < 3u; ++i)
+					darts_order[position + i] = d.index + i;
+			}
+		}
+	}
+	else
+	{
+		// darts are grouped by vertex (counting sort, darts of a vertex keep their relative order)
+		for (Dart d = base.begin(), end = base.end(); d != end; d = base.next(d))
+			++offsets[dart_rank(d.index) + 1u];
+		for (uint32 i = 0u; i <= nb_vertices; ++i)
+			offsets[i + 1u] += offsets[i];
+		for (Dart d = base.begin(), end = base.end(); d != end; d = base.next(d))
+			darts_order[offsets[dart_rank(d.index)]++] = d.index;
+	}
+
+	// the cells of the other orbits are numbered in the order of their first dart
+	std::array<std::vector<uint32>, NB_ORBITS> cells_orders;
+	cells_orders[Vertex::ORBIT] = std::move(full_vertex_order);
+	for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+	{
+		if (orbit == Vertex::ORBIT || !base.cells_indices_[orbit])
+			continue;
+		const auto& indices = *base.cells_indices_[orbit];
+		const auto& container = base.attribute_containers_[orbit];
+		std::vector<bool> ordered(container.maximum_index(), false);
+		std::vector<uint32>& order = cells_orders[orbit];
+		order.reserve(container.nb_elements());
+		for (uint32 d : darts_order)
+		{
+			const uint32 index = indices[d];
+			if (index != INVALID_INDEX && !ordered[index])
+			{
+				ordered[index] = true;
+				order.push_back(index);
+			}
+		}
+		// used indices that no dart refers to (if any) are put last
+		for (uint32 index = container.first_index(), end = container.last_index(); index != end;
+			 index = container.next_index(index))
+		{
+			if (!ordered[index])
+				order.push_back(index);
+		}
+	}
+
+	return base.reorder(darts_order, cells_orders);
+}
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_FUNCTIONS_REORDERING_H_
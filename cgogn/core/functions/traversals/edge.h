@@ -26,6 +26,7 @@
 
 #include <cgogn/core/cgogn_core_export.h>
 
+#include <cgogn/core/utils/small_vector.h>
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/type_traits.h>
 
@@ -70,7 +71,8 @@ auto foreach_incident_edge(const MESH& m, CELL c, const FUNC& func)
 	{
 		foreach_dart_of_orbit(m, c, [&](Dart d) -> bool { return func(Edge(d)); });
 	}
-	else if constexpr (std::is_convertible_v<MESH&, CMap2&> && mesh_traits<MESH>::dimension == 2 &&
+	else if constexpr ((std::is_convertible_v<MESH&, CMap2&> || std::is_convertible_v<MESH&, TriMap2&>) &&
+					   mesh_traits<MESH>::dimension == 2 &&
 					   (std::is_same_v<CELL, typename mesh_traits<MESH>::Vertex> ||
 						std::is_same_v<CELL, typename mesh_traits<MESH>::HalfEdge> ||
 						std::is_same_v<CELL, typename mesh_traits<MESH>::Face>))
@@ -117,10 +119,29 @@ auto foreach_incident_edge(const MESH& m, CELL c, const FUNC& func)
 	}
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH>
+class CompiledTopology;
+
+template <typename MESH, typename CELL, typename FUNC>
+void foreach_incident_edge(const CompiledTopology<MESH>& ct, CELL c, const FUNC& func)
+{
+	using Edge = typename mesh_traits<MESH>::Edge;
+
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, Edge>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	ct.template foreach_incident_or_fallback<Edge>(c, func);
+}
+
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Edge> incident_edges(MESH& m, CELL c);
+// CellsSmallVector<typename mesh_traits<MESH>::Edge> incident_edges(MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -129,11 +150,10 @@ auto foreach_incident_edge(const MESH& m, CELL c, const FUNC& func)
 /////////////
 
 template <typename MESH, typename CELL>
-std::vector<typename mesh_traits<MESH>::Edge> incident_edges(const MESH& m, CELL c)
+CellsSmallVector<typename mesh_traits<MESH>::Edge> incident_edges(const MESH& m, CELL c)
 {
 	using Edge = typename mesh_traits<MESH>::Edge;
-	std::vector<Edge> edges;
-	edges.reserve(32u);
+	CellsSmallVector<Edge> edges;
 	foreach_incident_edge(m, c, [&](Edge e) -> bool {
 		edges.push_back(e);
 		return true;
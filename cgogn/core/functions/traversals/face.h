@@ -26,6 +26,7 @@
 
 #include <cgogn/core/cgogn_core_export.h>
 
+#include <cgogn/core/utils/small_vector.h>
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/type_traits.h>
 
@@ -60,7 +61,8 @@ auto foreach_incident_face(const MESH& m, CELL c, const FUNC& func)
 	static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
-	if constexpr (std::is_convertible_v<MESH&, CMap2&> && mesh_traits<MESH>::dimension == 2 &&
+	if constexpr ((std::is_convertible_v<MESH&, CMap2&> || std::is_convertible_v<MESH&, TriMap2&>) &&
+				  mesh_traits<MESH>::dimension == 2 &&
 				  (std::is_same_v<CELL, typename mesh_traits<MESH>::Vertex> ||
 				   std::is_same_v<CELL, typename mesh_traits<MESH>::HalfEdge> ||
 				   std::is_same_v<CELL, typename mesh_traits<MESH>::Edge>))
@@ -142,10 +144,29 @@ auto foreach_incident_face(const MESH& m, CELL c, const FUNC& func)
 	}
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH>
+class CompiledTopology;
+
+template <typename MESH, typename CELL, typename FUNC>
+void foreach_incident_face(const CompiledTopology<MESH>& ct, CELL c, const FUNC& func)
+{
+	using Face = typename mesh_traits<MESH>::Face;
+
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	ct.template foreach_incident_or_fallback<Face>(c, func);
+}
+
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Face> incident_faces(MESH& m, CELL c);
+// CellsSmallVector<typename mesh_traits<MESH>::Face> incident_faces(MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -154,11 +175,10 @@ auto foreach_incident_face(const MESH& m, CELL c, const FUNC& func)
 /////////////
 
 template <typename MESH, typename CELL>
-std::vector<typename mesh_traits<MESH>::Face> incident_faces(const MESH& m, CELL c)
+CellsSmallVector<typename mesh_traits<MESH>::Face> incident_faces(const MESH& m, CELL c)
 {
 	using Face = typename mesh_traits<MESH>::Face;
-	std::vector<Face> faces;
-	faces.reserve(32u);
+	CellsSmallVector<Face> faces;
 	foreach_incident_face(m, c, [&](Face f) -> bool {
 		faces.push_back(f);
 		return true;
@@ -29,6 +29,7 @@
 #include <cgogn/core/utils/thread_pool.h>
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/work_stealing.h>
 
 #include <cgogn/core/types/cell_marker.h>
 #include <cgogn/core/types/mesh_traits.h>
@@ -59,6 +60,17 @@ auto foreach_cell(const MESH& m, const FUNC& f) -> std::enable_if_t<std::is_conv
 	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
+	if constexpr (std::is_convertible_v<MESH&, TriMap2&> && std::is_same_v<CELL, TriMap2::Face>)
+	{
+		// the faces of a TriMap2 are its non boundary darts triples: no marker is needed
+		for (Dart d = m.begin(), end = m.end(); d != end; d = m.next(Dart(d.index + 2u)))
+		{
+			if (!is_boundary(m, d) && !f(CELL(d)))
+				break;
+		}
+		return;
+	}
+
 	if (is_indexed<CELL>(m))
 	{
 		CellMarker<MESH, CELL> cm(m);
@@ -135,6 +147,27 @@ void foreach_cell(const CellFilter<MESH>& cf, const FUNC& f)
 	});
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH>
+class CompiledTopology;
+
+template <typename MESH, typename FUNC>
+void foreach_cell(const CompiledTopology<MESH>& ct, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	if (ct.template is_built<CELL>())
+		foreach_cell(ct.cell_cache(), f);
+	else
+		foreach_cell(static_cast<const MESH&>(ct), f);
+}
+
 /*****************************************************************************/
 
 // template <typename MESH, typename FUNC>
@@ -159,6 +192,20 @@ auto parallel_foreach_cell(const MESH& m, const FUNC& f) -> std::enable_if_t<std
 	if (nb_workers == 0)
 		return foreach_cell(m, f);
 
+	if constexpr (std::is_convertible_v<MESH&, TriMap2&> && std::is_same_v<CELL, TriMap2::Face>)
+	{
+		// see foreach_cell
+		parallel_foreach_range(0u, (m.darts_.maximum_index() + 2u) / 3u, [&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+			{
+				const Dart d(3u * i);
+				if (m.darts_.is_used(d.index) && !is_boundary(m, d))
+					f(CELL(d));
+			}
+		});
+		return;
+	}
+
 	using VecCell = std::vector<uint32>;
 	using Future = std::future<void>;
 
@@ -208,7 +255,7 @@ auto parallel_foreach_cell(const MESH& m, const FUNC& f) -> std::enable_if_t<std
 				j = 0u;
 				i = (i + 1u) % 2u;
 				for (auto& fu : futures[i])
-					fu.wait();
+					pool->wait(fu);
 				for (auto& b : cells_buffers[i])
 					buffers->release_buffer(b);
 				futures[i].clear();
@@ -250,7 +297,7 @@ auto parallel_foreach_cell(const MESH& m, const FUNC& f) -> std::enable_if_t<std
 				j = 0u;
 				i = (i + 1u) % 2u;
 				for (auto& fu : futures[i])
-					fu.wait();
+					pool->wait(fu);
 				for (auto& b : cells_buffers[i])
 					buffers->release_buffer(b);
 				futures[i].clear();
@@ -261,11 +308,11 @@ auto parallel_foreach_cell(const MESH& m, const FUNC& f) -> std::enable_if_t<std
 
 	// clean all at the end
 	for (auto& fu : futures[0u])
-		fu.wait();
+		pool->wait(fu);
 	for (auto& b : cells_buffers[0u])
 		buffers->release_buffer(b);
 	for (auto& fu : futures[1u])
-		fu.wait();
+		pool->wait(fu);
 	for (auto& b : cells_buffers[1u])
 		buffers->release_buffer(b);
 }
@@ -327,7 +374,7 @@ void parallel_foreach_cell(const CellCache<MESH>& cc, const FUNC& f)
 			j = 0;
 			i = (i + 1u) % 2u;
 			for (auto& fu : futures[i])
-				fu.wait();
+				pool->wait(fu);
 			for (auto& b : cells_buffers[i])
 				buffers->release_buffer(b);
 			futures[i].clear();
@@ -337,11 +384,11 @@ void parallel_foreach_cell(const CellCache<MESH>& cc, const FUNC& f)
 
 	// clean all at the end
 	for (auto& fu : futures[0u])
-		fu.wait();
+		pool->wait(fu);
 	for (auto& b : cells_buffers[0u])
 		buffers->release_buffer(b);
 	for (auto& fu : futures[1u])
-		fu.wait();
+		pool->wait(fu);
 	for (auto& b : cells_buffers[1u])
 		buffers->release_buffer(b);
 }
@@ -366,6 +413,307 @@ void parallel_foreach_cell(const CellFilter<MESH>& cf, const FUNC& f)
 	});
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH, typename FUNC>
+void parallel_foreach_cell(const CompiledTopology<MESH>& ct, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	if (ct.template is_built<CELL>())
+		parallel_foreach_cell(ct.cell_cache(), f);
+	else
+		parallel_foreach_cell(static_cast<const MESH&>(ct), f);
+}
+
+/*****************************************************************************/
+
+// template <typename MESH, typename FUNC>
+// void parallel_foreach_cell_work_stealing(MESH& m, const FUNC& f);
+
+/*****************************************************************************/
+
+///////////////////////////////
+// CMapBase (or convertible) //
+///////////////////////////////
+
+/**
+ * @brief apply f on each cell of m using all the workers of the thread pool
+ * The dart index space is split into per-worker ranges with work stealing (see parallel_foreach_range).
+ * There is no sequential marking pass: each worker only calls f on the cells owned by the darts
+ * of its ranges (see is_cell_owner), so each cell is processed exactly once.
+ * The return value of f is ignored, the traversal cannot be stopped.
+ */
+template <typename MESH, typename FUNC>
+auto parallel_foreach_cell_work_stealing(const MESH& m, const FUNC& f)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>>
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	if (thread_pool()->nb_workers() == 0)
+		return foreach_cell(m, f);
+
+	parallel_foreach_range(m.begin().index, m.end().index, [&](uint32 begin, uint32 end) {
+		for (Dart d = begin == 0u ? m.begin() : m.next(Dart(begin - 1u)); d.index < end; d = m.next(d))
+		{
+			CELL c(d);
+			if (is_cell_owner(m, c))
+				f(c);
+		}
+	});
+}
+
+///////////////
+// CellCache //
+///////////////
+
+template <typename MESH, typename FUNC>
+void parallel_foreach_cell_work_stealing(const CellCache<MESH>& cc, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	if (thread_pool()->nb_workers() == 0)
+		return foreach_cell(cc, f);
+
+	auto cells = cc.template begin<CELL>();
+	parallel_foreach_range(0u, cc.template size<CELL>(), [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+			f(cells[i]);
+	});
+}
+
+////////////////
+// CellFilter //
+////////////////
+
+template <typename MESH, typename FUNC>
+void parallel_foreach_cell_work_stealing(const CellFilter<MESH>& cf, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	const MESH& m = static_cast<const MESH&>(cf);
+	parallel_foreach_cell_work_stealing(m, [&](CELL c) -> bool {
+		if (cf.filter(c))
+			return f(c);
+		return true;
+	});
+}
+
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH, typename FUNC>
+void parallel_foreach_cell_work_stealing(const CompiledTopology<MESH>& ct, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	if (ct.template is_built<CELL>())
+		parallel_foreach_cell_work_stealing(ct.cell_cache(), f);
+	else
+		parallel_foreach_cell_work_stealing(static_cast<const MESH&>(ct), f);
+}
+
+/*****************************************************************************/
+
+// template <typename MESH, typename CELL, typename FUNC>
+// void parallel_foreach_cell_colored(const CellColoring<MESH, CELL>& cc, const FUNC& f);
+
+/*****************************************************************************/
+
+template <typename MESH, typename CELL>
+class CellColoring;
+
+/**
+ * @brief apply f on each colored cell of cc using all the workers of the thread pool
+ * The color classes are processed one after the other, the cells of a class in parallel (with work stealing).
+ * Following the conflict relation of the coloring, f may write into the neighborhood of its cell.
+ * The return value of f is ignored, the traversal cannot be stopped.
+ */
+template <typename MESH, typename CELL, typename FUNC>
+void parallel_foreach_cell_colored(const CellColoring<MESH, CELL>& cc, const FUNC& f)
+{
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	const std::vector<CELL>& cells = cc.cells();
+	for (uint32 color = 0u, nb_colors = cc.nb_colors(); color < nb_colors; ++color)
+	{
+		parallel_foreach_range(cc.color_begin(color), cc.color_end(color), [&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+				f(cells[i]);
+		});
+	}
+}
+
+/*****************************************************************************/
+
+// template <typename T, typename MESH, typename FUNC, typename COMBINE>
+// T parallel_reduce_cell(const MESH& m, const T& identity, const FUNC& f, const COMBINE& combine);
+
+/*****************************************************************************/
+
+///////////////////////////////
+// CMapBase (or convertible) //
+///////////////////////////////
+
+/**
+ * @brief reduce the cells of m using all the workers of the thread pool
+ * The darts index space is cut into fixed blocks of WORK_STEALING_GRAIN_SIZE darts. The cells owned by the darts
+ * of a block (see is_cell_owner) are accumulated in order in the partial result of the block, which starts from
+ * identity. The partial results are then combined in the order of the blocks. As the blocks depend neither on
+ * the number of workers nor on the scheduling, the result is reproducible (even for floating-point sums).
+ * @param identity the neutral element of combine
+ * @param f a callable with signature void(T& acc, CELL c) that accumulates c in acc
+ * @param combine a callable with signature T(T, T)
+ */
+template <typename T, typename MESH, typename FUNC, typename COMBINE>
+auto parallel_reduce_cell(const MESH& m, const T& identity, const FUNC& f, const COMBINE& combine)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>, T>
+{
+	using CELL = func_ith_parameter_type<FUNC, 1>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_ith_func_parameter_same<FUNC, 0, T&>::value, "Wrong function accumulator parameter type");
+
+	const uint32 last = m.end().index;
+	const uint32 block_size = WORK_STEALING_GRAIN_SIZE;
+	std::vector<CacheLinePadded<T>> partial_results((last + block_size - 1u) / block_size, {identity});
+	parallel_foreach_range(
+		0u, last,
+		[&](uint32 begin, uint32 end) {
+			for (uint32 b = begin; b < end; b += block_size)
+			{
+				T& acc = partial_results[b / block_size].value;
+				const uint32 block_end = std::min(b + block_size, end);
+				for (Dart d = b == 0u ? m.begin() : m.next(Dart(b - 1u)); d.index < block_end; d = m.next(d))
+				{
+					CELL c(d);
+					if (is_cell_owner(m, c))
+						f(acc, c);
+				}
+			}
+		},
+		block_size);
+
+	T result = identity;
+	for (CacheLinePadded<T>& r : partial_results)
+		result = combine(std::move(result), std::move(r.value));
+	return result;
+}
+
+///////////////
+// CellCache //
+///////////////
+
+template <typename T, typename MESH, typename FUNC, typename COMBINE>
+T parallel_reduce_cell(const CellCache<MESH>& cc, const T& identity, const FUNC& f, const COMBINE& combine)
+{
+	using CELL = func_ith_parameter_type<FUNC, 1>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_ith_func_parameter_same<FUNC, 0, T&>::value, "Wrong function accumulator parameter type");
+
+	auto cells = cc.template begin<CELL>();
+	const uint32 last = cc.template size<CELL>();
+	const uint32 block_size = WORK_STEALING_GRAIN_SIZE;
+	std::vector<CacheLinePadded<T>> partial_results((last + block_size - 1u) / block_size, {identity});
+	parallel_foreach_range(
+		0u, last,
+		[&](uint32 begin, uint32 end) {
+			for (uint32 b = begin; b < end; b += block_size)
+			{
+				T& acc = partial_results[b / block_size].value;
+				for (uint32 i = b, block_end = std::min(b + block_size, end); i < block_end; ++i)
+					f(acc, cells[i]);
+			}
+		},
+		block_size);
+
+	T result = identity;
+	for (CacheLinePadded<T>& r : partial_results)
+		result = combine(std::move(result), std::move(r.value));
+	return result;
+}
+
+/*****************************************************************************/
+
+// template <typename T, typename MESH, typename COMBINE, typename FUNC>
+// T parallel_transform_reduce_cell(const MESH& m, const T& identity, const COMBINE& combine, const FUNC& f);
+
+/*****************************************************************************/
+
+/////////////
+// GENERIC //
+/////////////
+
+/**
+ * @brief combine the values f(c) of all the cells c of m using all the workers of the thread pool
+ * The combination order is reproducible (see parallel_reduce_cell).
+ * @param identity the neutral element of combine
+ * @param combine a callable with signature T(T, T)
+ * @param f a callable with signature T(CELL c)
+ */
+template <typename T, typename MESH, typename COMBINE, typename FUNC>
+T parallel_transform_reduce_cell(const MESH& m, const T& identity, const COMBINE& combine, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+
+	return parallel_reduce_cell(
+		m, identity, [&](T& acc, CELL c) { acc = combine(std::move(acc), f(c)); }, combine);
+}
+
+/*****************************************************************************/
+
+// template <typename MESH, typename FUNC>
+// std::vector<CELL> parallel_collect_cell(const MESH& m, const FUNC& f);
+
+/*****************************************************************************/
+
+/////////////
+// GENERIC //
+/////////////
+
+/**
+ * @brief collect the cells c of m for which f(c) returns true using all the workers of the thread pool
+ * The cells are given in a reproducible order (see parallel_reduce_cell).
+ * @param f a callable with signature bool(CELL c)
+ */
+template <typename MESH, typename FUNC>
+std::vector<func_parameter_type<FUNC>> parallel_collect_cell(const MESH& m, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	return parallel_reduce_cell(
+		m, std::vector<CELL>(),
+		[&](std::vector<CELL>& cells, CELL c) {
+			if (f(c))
+				cells.push_back(c);
+		},
+		[](std::vector<CELL> a, std::vector<CELL> b) {
+			a.insert(a.end(), b.begin(), b.end());
+			return a;
+		});
+}
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_FUNCTIONS_TRAVERSALS_GLOBAL_H_
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/cgogn_core_export.h>
 
+#include <cgogn/core/utils/small_vector.h>
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/type_traits.h>
 
@@ -70,7 +71,8 @@ auto foreach_incident_vertex(const MESH& m, CELL c, const FUNC& func)
 	{
 		foreach_dart_of_orbit(m, c, [&](Dart d) -> bool { return func(Vertex(d)); });
 	}
-	else if constexpr (std::is_convertible_v<MESH&, CMap2&> && mesh_traits<MESH>::dimension == 2 &&
+	else if constexpr ((std::is_convertible_v<MESH&, CMap2&> || std::is_convertible_v<MESH&, TriMap2&>) &&
+					   mesh_traits<MESH>::dimension == 2 &&
 					   (std::is_same_v<CELL, typename mesh_traits<MESH>::Edge> ||
 						std::is_same_v<CELL, typename mesh_traits<MESH>::Face>))
 	{
@@ -122,6 +124,29 @@ auto foreach_incident_vertex(const MESH& m, CELL c, const FUNC& func)
 	}
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH>
+class CompiledTopology;
+
+template <typename MESH, typename CELL, typename FUNC>
+void foreach_incident_vertex(const CompiledTopology<MESH>& ct, CELL c, const FUNC& func)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	// the (Vertex, Vertex) table holds the adjacent vertices
+	if constexpr (std::is_same_v<CELL, Vertex>)
+		func(c);
+	else
+		ct.template foreach_incident_or_fallback<Vertex>(c, func);
+}
+
 /*****************************************************************************/
 
 // template <typename MESH, typename FUNC>
@@ -146,7 +171,8 @@ auto foreach_adjacent_vertex_through_edge(const MESH& m, typename mesh_traits<ME
 	{
 		foreach_dart_of_orbit(m, v, [&](Dart d) -> bool { return func(Vertex(alpha0(m, d))); });
 	}
-	else if constexpr (std::is_convertible_v<MESH&, CMap2&> && mesh_traits<MESH>::dimension == 2)
+	else if constexpr ((std::is_convertible_v<MESH&, CMap2&> || std::is_convertible_v<MESH&, TriMap2&>) &&
+					   mesh_traits<MESH>::dimension == 2)
 	{
 		foreach_dart_of_orbit(m, v, [&](Dart d) -> bool { return func(Vertex(phi2(m, d))); });
 	}
@@ -184,10 +210,26 @@ auto foreach_adjacent_vertex_through_edge(const MESH& m, typename mesh_traits<ME
 	}
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH, typename FUNC>
+void foreach_adjacent_vertex_through_edge(const CompiledTopology<MESH>& ct, typename mesh_traits<MESH>::Vertex v,
+										  const FUNC& func)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+
+	static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	ct.template foreach_incident_or_fallback<Vertex>(v, func);
+}
+
 /*****************************************************************************/
 
 // template <typename CELL, typename MESH>
-// std::vector<typename mesh_traits<MESH>::Vertex> incident_vertices(const MESH& m, CELL c);
+// CellsSmallVector<typename mesh_traits<MESH>::Vertex> incident_vertices(const MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -196,11 +238,10 @@ auto foreach_adjacent_vertex_through_edge(const MESH& m, typename mesh_traits<ME
 /////////////
 
 template <typename MESH, typename CELL>
-std::vector<typename mesh_traits<MESH>::Vertex> incident_vertices(const MESH& m, CELL c)
+CellsSmallVector<typename mesh_traits<MESH>::Vertex> incident_vertices(const MESH& m, CELL c)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices;
-	vertices.reserve(32u);
+	CellsSmallVector<Vertex> vertices;
 	foreach_incident_vertex(m, c, [&](Vertex v) -> bool {
 		vertices.push_back(v);
 		return true;
@@ -222,7 +263,7 @@ void incident_vertices(const MESH& m, CELL c, std::vector<typename mesh_traits<M
 /*****************************************************************************/
 
 // template <typename MESH>
-// std::vector<typename mesh_traits<MESH>::Vertex>
+// CellsSmallVector<typename mesh_traits<MESH>::Vertex>
 // adjacent_vertices_through_edge(MESH& m, typename mesh_traits<MESH>::Vertex v);
 
 /*****************************************************************************/
@@ -232,12 +273,11 @@ void incident_vertices(const MESH& m, CELL c, std::vector<typename mesh_traits<M
 /////////////
 
 template <typename MESH>
-std::vector<typename mesh_traits<MESH>::Vertex> adjacent_vertices_through_edge(const MESH& m,
-																			   typename mesh_traits<MESH>::Vertex v)
+CellsSmallVector<typename mesh_traits<MESH>::Vertex> adjacent_vertices_through_edge(
+	const MESH& m, typename mesh_traits<MESH>::Vertex v)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices;
-	vertices.reserve(32u);
+	CellsSmallVector<Vertex> vertices;
 	foreach_adjacent_vertex_through_edge(m, v, [&](Vertex av) -> bool {
 		vertices.push_back(av);
 		return true;
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/cgogn_core_export.h>
 
+#include <cgogn/core/utils/small_vector.h>
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/type_traits.h>
 
@@ -60,7 +61,8 @@ auto foreach_incident_volume(const MESH& m, CELL c, const FUNC& func)
 	static_assert(is_func_parameter_same<FUNC, Volume>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
-	if constexpr (std::is_convertible_v<MESH&, CMap2&> && mesh_traits<MESH>::dimension == 2)
+	if constexpr ((std::is_convertible_v<MESH&, CMap2&> || std::is_convertible_v<MESH&, TriMap2&>) &&
+				  mesh_traits<MESH>::dimension == 2)
 	{
 		func(Volume(c.dart));
 	}
@@ -149,10 +151,29 @@ auto foreach_incident_volume(const MESH& m, CELL c, const FUNC& func)
 	}
 }
 
+//////////////////////
+// CompiledTopology //
+//////////////////////
+
+template <typename MESH>
+class CompiledTopology;
+
+template <typename MESH, typename CELL, typename FUNC>
+void foreach_incident_volume(const CompiledTopology<MESH>& ct, CELL c, const FUNC& func)
+{
+	using Volume = typename mesh_traits<MESH>::Volume;
+
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, Volume>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	ct.template foreach_incident_or_fallback<Volume>(c, func);
+}
+
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Volume> incident_volumes(const MESH& m, CELL c);
+// CellsSmallVector<typename mesh_traits<MESH>::Volume> incident_volumes(const MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -161,15 +182,14 @@ auto foreach_incident_volume(const MESH& m, CELL c, const FUNC& func)
 /////////////
 
 template <typename MESH, typename CELL>
-std::vector<typename mesh_traits<MESH>::Volume> incident_volumes(const MESH& m, CELL c)
+CellsSmallVector<typename mesh_traits<MESH>::Volume> incident_volumes(const MESH& m, CELL c)
 {
 	using Volume = typename mesh_traits<MESH>::Volume;
 	if constexpr (mesh_traits<MESH>::dimension == 2)
 		return {Volume(c.dart)};
 	else
 	{
-		std::vector<Volume> volumes;
-		volumes.reserve(32u);
+		CellsSmallVector<Volume> volumes;
 		foreach_incident_volume(m, c, [&](Volume v) -> bool {
 			volumes.push_back(v);
 			return true;
@@ -97,21 +97,21 @@ public:
 
 	inline void mark(CELL c)
 	{
-		(*mark_attribute_)[index_of(mesh_, c)] = 1u;
+		mark_attribute_->set_true(index_of(mesh_, c));
 	}
 	inline void unmark(CELL c)
 	{
-		(*mark_attribute_)[index_of(mesh_, c)] = 0u;
+		mark_attribute_->set_false(index_of(mesh_, c));
 	}
 
 	inline bool is_marked(CELL c) const
 	{
-		return (*mark_attribute_)[index_of(mesh_, c)] != 0u;
+		return (*mark_attribute_)[index_of(mesh_, c)];
 	}
 
 	inline void unmark_all()
 	{
-		mark_attribute_->fill(0u);
+		mark_attribute_->all_false();
 	}
 };
 
@@ -143,7 +143,7 @@ public:
 		if (!is_marked(c))
 		{
 			uint32 index = index_of(mesh_, c);
-			(*mark_attribute_)[index] = 1u;
+			mark_attribute_->set_true(index);
 			marked_cells_.push_back(index);
 		}
 	}
@@ -154,7 +154,7 @@ public:
 		auto it = std::find(marked_cells_.begin(), marked_cells_.end(), index);
 		if (it != marked_cells_.end())
 		{
-			(*mark_attribute_)[index] = 0u;
+			mark_attribute_->set_false(index);
 			std::swap(*it, marked_cells_.back());
 			marked_cells_.pop_back();
 		}
@@ -162,13 +162,20 @@ public:
 
 	inline bool is_marked(CELL c) const
 	{
-		return (*mark_attribute_)[index_of(mesh_, c)] != 0u;
+		return (*mark_attribute_)[index_of(mesh_, c)];
 	}
 
+	// marked cells are unmarked one by one, unless clearing the chunks they belong to is cheaper
 	inline void unmark_all()
 	{
-		for (uint32 i : marked_cells_)
-			(*mark_attribute_)[i] = 0u;
+		using MarkAttribute = typename mesh_traits<MESH>::MarkAttribute;
+		if (marked_cells_.size() < mark_attribute_->nb_dirty_chunks() * MarkAttribute::CHUNK_NB_WORDS)
+		{
+			for (uint32 i : marked_cells_)
+				mark_attribute_->set_false(i);
+		}
+		else
+			mark_attribute_->all_false();
 		marked_cells_.clear();
 	}
 
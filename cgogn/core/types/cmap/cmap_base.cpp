@@ -23,16 +23,97 @@
 
 #include <cgogn/core/types/cmap/cmap_base.h>
 
+#include <cgogn/core/utils/work_stealing.h>
+
 namespace cgogn
 {
 
-CMapBase::CMapBase()
+CMapBase::CMapBase() : nb_cells_valid_orbits_(0u), nb_cells_updates_depth_(0u)
 {
 	boundary_marker_ = darts_.get_mark_attribute();
+	for (std::atomic<uint32>& n : nb_cells_)
+		n.store(0u, std::memory_order_relaxed);
 }
 
 CMapBase::~CMapBase()
 {
+	// map attributes may keep attributes of the containers (e.g. derived attributes): release them first
+	attributes_.clear();
+}
+
+// the darts attributes values have been moved, now update the relations & indices they store
+static void update_darts_references(CMapBase& m, const CMapBase::CompactMapping& mapping)
+{
+	parallel_foreach_range(0u, m.darts_.maximum_index(), [&](uint32 begin, uint32 end) {
+		for (auto& relation : m.relations_)
+		{
+			for (uint32 i = begin; i < end; ++i)
+			{
+				Dart& d = (*relation)[i];
+				if (!d.is_nil())
+					d = Dart(mapping.darts[d.index]);
+			}
+		}
+		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		{
+			if (!m.cells_indices_[orbit])
+				continue;
+			for (uint32 i = begin; i < end; ++i)
+			{
+				uint32& index = (*m.cells_indices_[orbit])[i];
+				if (index != INVALID_INDEX)
+					index = mapping.cells[orbit][index];
+			}
+		}
+	});
+}
+
+CMapBase::CompactMapping CMapBase::compact()
+{
+	CompactMapping mapping;
+
+	for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		mapping.cells[orbit] = attribute_containers_[orbit].compact();
+	mapping.darts = darts_.compact();
+
+	update_darts_references(*this, mapping);
+
+	return mapping;
+}
+
+CMapBase::CompactMapping CMapBase::reorder(const std::vector<uint32>& darts_order,
+										   const std::array<std::vector<uint32>, NB_ORBITS>& cells_orders)
+{
+	CompactMapping mapping;
+
+	for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		mapping.cells[orbit] = cells_orders[orbit].empty() ? attribute_containers_[orbit].compact()
+														   : attribute_containers_[orbit].reorder(cells_orders[orbit]);
+	mapping.darts = darts_order.empty() ? darts_.compact() : darts_.reorder(darts_order);
+
+	update_darts_references(*this, mapping);
+
+	return mapping;
+}
+
+CMapBase::MemoryReport CMapBase::memory_report() const
+{
+	MemoryReport report;
+	report.darts = darts_.memory_report();
+	for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+	{
+		if (cells_indices_[orbit])
+			report.cells.emplace_back(Orbit(orbit), attribute_containers_[orbit].memory_report());
+	}
+	return report;
+}
+
+std::size_t CMapBase::MemoryReport::total_bytes() const
+{
+	std::size_t bytes = darts.total_bytes();
+	for (const auto& [orbit, r] : cells)
+		bytes += r.total_bytes();
+	return bytes;
 }
 
 } // namespace cgogn
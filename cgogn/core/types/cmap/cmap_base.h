@@ -34,6 +34,7 @@
 
 #include <any>
 #include <array>
+#include <atomic>
 #include <unordered_map>
 
 namespace cgogn
@@ -72,9 +73,54 @@ struct CGOGN_CORE_EXPORT CMapBase
 	/*************************************************************************/
 	mutable std::array<AttributeContainer, NB_ORBITS> attribute_containers_;
 
+	/*************************************************************************/
+	// Cells counts
+	/*************************************************************************/
+	// number of cells of each orbit (see nb_cells), valid for the orbits whose bit is set in nb_cells_valid_orbits_
+	mutable std::array<std::atomic<uint32>, NB_ORBITS> nb_cells_;
+	mutable std::atomic<uint32> nb_cells_valid_orbits_;
+	// depth of the nested topological operations that maintain the cells counts (see CellsCountsUpdate)
+	mutable uint32 nb_cells_updates_depth_;
+
 	CMapBase();
 	~CMapBase();
 
+	// old-to-new index mappings of the darts and of the cells of each orbit (INVALID_INDEX for unused old indices)
+	struct CompactMapping
+	{
+		std::vector<uint32> darts;
+		std::array<std::vector<uint32>, NB_ORBITS> cells;
+	};
+
+	/**
+	 * @brief renumber the darts and the cells of all orbits contiguously and release unused memory
+	 * The relations and the cells indices of the darts are updated accordingly.
+	 * Darts or cells indices stored elsewhere (user attributes, CellCache, ...) must be updated
+	 * by the caller using the returned mapping.
+	 */
+	CompactMapping compact();
+
+	/**
+	 * @brief renumber the darts and the cells of the orbits in the given orders (e.g. to improve memory locality)
+	 * darts_order (resp. cells_orders[orbit]) lists the used dart (resp. cell) indices in their new order:
+	 * the dart of index darts_order[i] gets index i. An empty order compacts the container without reordering.
+	 * As with compact, the relations and the cells indices of the darts are updated accordingly and the
+	 * darts or cells indices stored elsewhere must be updated by the caller using the returned mapping.
+	 */
+	CompactMapping reorder(const std::vector<uint32>& darts_order,
+						   const std::array<std::vector<uint32>, NB_ORBITS>& cells_orders);
+
+	// memory footprint of the darts container and of the containers of the indexed orbits
+	struct MemoryReport
+	{
+		AttributeContainer::MemoryReport darts;
+		std::vector<std::pair<Orbit, AttributeContainer::MemoryReport>> cells;
+
+		std::size_t total_bytes() const;
+	};
+
+	MemoryReport memory_report() const;
+
 	template <typename T>
 	T& get_attribute(const std::string& name)
 	{
@@ -87,6 +133,14 @@ struct CGOGN_CORE_EXPORT CMapBase
 		return relations_.emplace_back(darts_.add_attribute<Dart>(name));
 	}
 
+	// called by each topological modification
+	// (the counts are only read first, not to write into a shared cache line from concurrent modifications)
+	inline void invalidate_nb_cells() const
+	{
+		if (nb_cells_valid_orbits_.load(std::memory_order_relaxed) != 0u)
+			nb_cells_valid_orbits_.store(0u, std::memory_order_relaxed);
+	}
+
 	inline Dart begin() const
 	{
 		return Dart(darts_.first_index());
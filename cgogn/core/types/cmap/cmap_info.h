@@ -68,7 +68,59 @@ uint32 nb_darts_of_orbit(const CMAP& m, CELL c)
 
 inline bool is_boundary(const CMapBase& m, Dart d)
 {
-	return (*m.boundary_marker_)[d.index] != 0u;
+	return (*m.boundary_marker_)[d.index];
+}
+
+/*****************************************************************************/
+
+// template <typename CELL, typename CMAP>
+// bool is_cell_owner(const CMAP& m, CELL c)
+
+/*****************************************************************************/
+
+/////////////
+// GENERIC //
+/////////////
+
+/**
+ * @brief check if the dart of c owns its cell, i.e. is the non boundary dart of the orbit with the smallest index
+ * The owner is the dart from which a sequential foreach_cell reaches the cell, so each cell
+ * has exactly one owner and ownership can be checked concurrently without any marker.
+ */
+template <typename CELL, typename CMAP>
+bool is_cell_owner(const CMAP& m, CELL c)
+{
+	if (is_boundary(m, c.dart))
+		return false;
+	if constexpr (CELL::ORBIT == DART)
+		return true;
+	else
+	{
+		bool owner = true;
+		auto check = [&](Dart d) -> bool {
+			if (d.index < c.dart.index && !is_boundary(m, d))
+				owner = false;
+			return owner;
+		};
+		// the traversals of these orbits need a marker: most darts are first rejected from a sub-orbit
+		// (the face of the dart and its phi2 adjacent faces, or the vertex of the dart in its volume)
+		if constexpr (CELL::ORBIT == PHI1_PHI2 || CELL::ORBIT == PHI1_PHI2_PHI3)
+		{
+			foreach_dart_of_orbit(m, Cell<PHI1>(c.dart), check);
+			if (owner)
+			{
+				foreach_dart_of_orbit(m, Cell<PHI1>(c.dart), [&](Dart d) -> bool {
+					foreach_dart_of_orbit(m, Cell<PHI1>(phi2(m, d)), check);
+					return owner;
+				});
+			}
+		}
+		if constexpr (CELL::ORBIT == PHI21_PHI31)
+			foreach_dart_of_orbit(m, Cell<PHI21>(c.dart), check);
+		if (owner)
+			foreach_dart_of_orbit(m, c, check);
+		return owner;
+	}
 }
 
 /*****************************************************************************/
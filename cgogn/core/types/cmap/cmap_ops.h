@@ -47,6 +47,7 @@ namespace cgogn
 
 inline Dart add_dart(CMapBase& m)
 {
+	m.invalidate_nb_cells();
 	uint32 index = m.darts_.new_index();
 	Dart d(index);
 	for (auto rel : m.relations_)
@@ -78,6 +79,25 @@ inline Dart add_dart(CPH3& m)
 	return d;
 }
 
+/////////////
+// TriMap2 //
+/////////////
+
+/**
+ * @brief add the 3 darts of a triangle (or of a triple of boundary darts) of a TriMap2
+ * The darts of a TriMap2 are only released by whole triples (see remove_triangle_darts), in reverse order:
+ * the 3 new indices are then either popped together from the free list or appended after the last triple.
+ * @return the first dart of the triple (its index is a multiple of 3)
+ */
+inline Dart add_triangle_darts(TriMap2& m)
+{
+	Dart d = add_dart(m);
+	add_dart(m);
+	add_dart(m);
+	cgogn_message_assert(d.index % 3u == 0u, "TriMap2: misaligned darts triple");
+	return d;
+}
+
 /*****************************************************************************/
 
 // template <typename CMAP>
@@ -91,6 +111,7 @@ inline Dart add_dart(CPH3& m)
 
 inline void remove_dart(CMapBase& m, Dart d)
 {
+	m.invalidate_nb_cells();
 	for (uint32 orbit = 0; orbit < uint32(m.attribute_containers_.size()); ++orbit)
 	{
 		if (m.cells_indices_[orbit])
@@ -103,6 +124,18 @@ inline void remove_dart(CMapBase& m, Dart d)
 	m.darts_.release_index(d.index);
 }
 
+/////////////
+// TriMap2 //
+/////////////
+
+inline void remove_triangle_darts(TriMap2& m, Dart d)
+{
+	cgogn_message_assert(d.index % 3u == 0u, "TriMap2: misaligned darts triple");
+	remove_dart(m, Dart(d.index + 2u));
+	remove_dart(m, Dart(d.index + 1u));
+	remove_dart(m, d);
+}
+
 /*****************************************************************************/
 
 // template <typename CMAP>
@@ -116,7 +149,8 @@ inline void remove_dart(CMapBase& m, Dart d)
 
 inline void set_boundary(const CMapBase& m, Dart d, bool b)
 {
-	(*m.boundary_marker_)[d.index] = b ? 1u : 0u;
+	m.invalidate_nb_cells();
+	m.boundary_marker_->set_value(d.index, b);
 }
 
 /*****************************************************************************/
@@ -135,6 +169,7 @@ void set_index(CMapBase& m, Dart d, uint32 index)
 {
 	static const Orbit orbit = CELL::ORBIT;
 	static_assert(orbit < NB_ORBITS, "Unknown orbit parameter");
+	m.invalidate_nb_cells();
 	const uint32 old = (*m.cells_indices_[orbit])[d.index];
 	// ref_index() is done before unref_index() to avoid deleting the index if old == index
 	if (index != INVALID_INDEX)
@@ -163,6 +198,60 @@ auto copy_index(MESH& m, Dart dest, Dart src) -> std::enable_if_t<std::is_conver
 	set_index<CELL>(m, dest, index_of(m, CELL(src)));
 }
 
+/*****************************************************************************/
+
+/**
+ * @brief keeps the cells counts of a map (see nb_cells) valid through a topological operation
+ * The counts that are valid when the object is built are restored when it is destroyed, shifted by the
+ * variations declared by the operation. The counts of the orbits without declared variation are left invalid.
+ * Only the outermost of nested operations restores the counts: the variations declared by the operations it
+ * calls (e.g. the CMap1 operations called by a CMap2 operation) are ignored.
+ */
+class CellsCountsUpdate
+{
+	const CMapBase& m_;
+	bool outermost_;
+	uint32 valid_orbits_;
+	uint32 updated_orbits_;
+	std::array<uint32, NB_ORBITS> nb_cells_;
+
+public:
+	inline CellsCountsUpdate(const CMapBase& m)
+		: m_(m), outermost_(m.nb_cells_updates_depth_++ == 0u),
+		  valid_orbits_(m.nb_cells_valid_orbits_.load(std::memory_order_acquire)), updated_orbits_(0u)
+	{
+		for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+			nb_cells_[orbit] = m_.nb_cells_[orbit].load(std::memory_order_relaxed);
+	}
+
+	inline ~CellsCountsUpdate()
+	{
+		--m_.nb_cells_updates_depth_;
+		if (!outermost_)
+			return;
+		const uint32 valid_orbits = valid_orbits_ & updated_orbits_;
+		for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+		{
+			if (valid_orbits & (1u << orbit))
+				m_.nb_cells_[orbit].store(nb_cells_[orbit], std::memory_order_relaxed);
+		}
+		m_.nb_cells_valid_orbits_.store(valid_orbits, std::memory_order_release);
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CellsCountsUpdate);
+
+	// the number of cells of type CELL changes by n (cells types that share an orbit share their variation)
+	template <typename CELL>
+	inline void set_variation(int32 n)
+	{
+		if (!(updated_orbits_ & (1u << CELL::ORBIT)))
+		{
+			updated_orbits_ |= 1u << CELL::ORBIT;
+			nb_cells_[CELL::ORBIT] += uint32(n);
+		}
+	}
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_CMAP_CMAP_OPS_H_
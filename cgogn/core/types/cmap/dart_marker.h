@@ -29,6 +29,8 @@
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/type_traits.h>
 
+#include <memory>
+
 namespace cgogn
 {
 
@@ -89,21 +91,21 @@ public:
 
 	inline void mark(Dart d)
 	{
-		(*mark_attribute_)[d.index] = 1u;
+		mark_attribute_->set_true(d.index);
 	}
 	inline void unmark(Dart d)
 	{
-		(*mark_attribute_)[d.index] = 0u;
+		mark_attribute_->set_false(d.index);
 	}
 
 	inline bool is_marked(Dart d) const
 	{
-		return (*mark_attribute_)[d.index] != 0u;
+		return (*mark_attribute_)[d.index];
 	}
 
 	inline void unmark_all()
 	{
-		mark_attribute_->fill(0u);
+		mark_attribute_->all_false();
 	}
 };
 
@@ -134,7 +136,7 @@ public:
 	{
 		if (!is_marked(d))
 		{
-			(*mark_attribute_)[d.index] = 1u;
+			mark_attribute_->set_true(d.index);
 			marked_darts_.push_back(d);
 		}
 	}
@@ -144,7 +146,7 @@ public:
 		auto it = std::find(marked_darts_.begin(), marked_darts_.end(), d);
 		if (it != marked_darts_.end())
 		{
-			(*mark_attribute_)[d.index] = 0u;
+			mark_attribute_->set_false(d.index);
 			std::swap(*it, marked_darts_.back());
 			marked_darts_.pop_back();
 		}
@@ -152,13 +154,19 @@ public:
 
 	inline bool is_marked(Dart d) const
 	{
-		return (*mark_attribute_)[d.index] != 0u;
+		return (*mark_attribute_)[d.index];
 	}
 
+	// marked darts are unmarked one by one, unless clearing the chunks they belong to is cheaper
 	inline void unmark_all()
 	{
-		for (Dart d : marked_darts_)
-			(*mark_attribute_)[d.index] = 0u;
+		if (marked_darts_.size() < mark_attribute_->nb_dirty_chunks() * CMAP::MarkAttribute::CHUNK_NB_WORDS)
+		{
+			for (Dart d : marked_darts_)
+				mark_attribute_->set_false(d.index);
+		}
+		else
+			mark_attribute_->all_false();
 		marked_darts_.clear();
 	}
 
@@ -168,6 +176,85 @@ public:
 	}
 };
 
+/**
+ * @brief marker for the small sets of darts met by local traversals (e.g. the darts of a CMap3 vertex)
+ * Up to CAPACITY darts are kept in a list stored in the object itself (i.e. on the stack), so no mark
+ * attribute is taken from the map (which would cost one bit per dart of the map for each thread running
+ * a traversal) and nothing has to be unmarked on destruction. Membership is tested through a small hash table.
+ * If more than CAPACITY darts are marked, it transparently switches to a DartMarkerStore.
+ */
+template <typename CMAP, uint32 CAPACITY = 128u>
+class SmallDartMarkerStore
+{
+	static_assert((CAPACITY & (CAPACITY - 1u)) == 0u, "CAPACITY must be a power of 2");
+
+	static const uint32 TABLE_SIZE = 2u * CAPACITY;
+
+private:
+	const CMAP& map_;
+	uint32 nb_marked_darts_;
+	Dart marked_darts_[CAPACITY];
+	uint32 table_[TABLE_SIZE];
+	std::unique_ptr<DartMarkerStore<CMAP>> marker_;
+
+	// returns the slot of d in the table or the empty slot where it should be inserted
+	inline uint32 table_slot(Dart d) const
+	{
+		uint32 h = (d.index * 2654435761u) & (TABLE_SIZE - 1u);
+		while (table_[h] != INVALID_INDEX && table_[h] != d.index)
+			h = (h + 1u) & (TABLE_SIZE - 1u);
+		return h;
+	}
+
+public:
+	SmallDartMarkerStore(const CMAP& map) : map_(map), nb_marked_darts_(0u)
+	{
+		std::fill(table_, table_ + TABLE_SIZE, INVALID_INDEX);
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(SmallDartMarkerStore);
+
+	inline void mark(Dart d)
+	{
+		if (marker_)
+		{
+			marker_->mark(d);
+			return;
+		}
+		const uint32 h = table_slot(d);
+		if (table_[h] == d.index)
+			return;
+		if (nb_marked_darts_ == CAPACITY)
+		{
+			marker_ = std::make_unique<DartMarkerStore<CMAP>>(map_);
+			for (uint32 i = 0u; i < nb_marked_darts_; ++i)
+				marker_->mark(marked_darts_[i]);
+			marker_->mark(d);
+			return;
+		}
+		table_[h] = d.index;
+		marked_darts_[nb_marked_darts_++] = d;
+	}
+
+	inline bool is_marked(Dart d) const
+	{
+		if (marker_)
+			return marker_->is_marked(d);
+		return table_[table_slot(d)] == d.index;
+	}
+
+	// marked darts are numbered in marking order
+	inline uint32 nb_marked_darts() const
+	{
+		return marker_ ? uint32(marker_->marked_darts().size()) : nb_marked_darts_;
+	}
+
+	inline Dart marked_dart(uint32 i) const
+	{
+		return marker_ ? marker_->marked_darts()[i] : marked_darts_[i];
+	}
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_TYPES_CMAP_DART_MARKER_H_
@@ -138,6 +138,19 @@ auto foreach_dart_of_PHI1(const MESH& m, Dart d, const FUNC& f)
 {
 	static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if constexpr (std::is_convertible_v<MESH&, TriMap2&>)
+	{
+		// the darts of a (non boundary) triangle are the 3 consecutive darts of its triple
+		if (!(*m.boundary_marker_)[d.index])
+		{
+			const uint32 r = d.index % 3u;
+			const Dart next(r == 2u ? d.index - 2u : d.index + 1u);
+			const Dart prev(r == 0u ? d.index + 2u : d.index - 1u);
+			if (f(d) && f(next))
+				f(prev);
+			return;
+		}
+	}
 	Dart it = d;
 	do
 	{
@@ -179,7 +192,7 @@ auto foreach_dart_of_PHI1_PHI2(const MESH& m, Dart d, const FUNC& f)
 	static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
-	DartMarkerStore<MESH> marker(m);
+	SmallDartMarkerStore<MESH> marker(m);
 
 	std::vector<Dart> visited_faces;
 	visited_faces.push_back(d); // Start with the face of d
@@ -245,25 +258,19 @@ auto foreach_dart_of_PHI21_PHI31(const MESH& m, Dart d, const FUNC& f)
 	static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
-	DartMarkerStore<MESH> marker(m);
-	const std::vector<Dart>& marked_darts = marker.marked_darts();
+	SmallDartMarkerStore<MESH> marker(m);
 
 	marker.mark(d);
-	for (uint32 i = 0; i < uint32(marked_darts.size()); ++i)
+	for (uint32 i = 0; i < marker.nb_marked_darts(); ++i)
 	{
-		const Dart curr_dart = marked_darts[i];
+		const Dart curr_dart = marker.marked_dart(i);
 		//			if ( !(is_boundary(curr_dart) && is_boundary(phi3(curr_dart))) )
 		if (!f(curr_dart))
 			break;
 
 		const Dart d_1 = phi_1(m, curr_dart);
-		const Dart d2_1 = phi2(m, d_1); // turn in volume
-		const Dart d3_1 = phi3(m, d_1); // change volume
-
-		if (!marker.is_marked(d2_1))
-			marker.mark(d2_1);
-		if (!marker.is_marked(d3_1))
-			marker.mark(d3_1);
+		marker.mark(phi2(m, d_1)); // turn in volume
+		marker.mark(phi3(m, d_1)); // change volume
 	}
 }
 
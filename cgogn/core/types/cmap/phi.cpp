@@ -23,10 +23,46 @@
 
 #include <cgogn/core/types/cmap/cph3.h>
 #include <cgogn/core/types/cmap/phi.h>
+#include <cgogn/core/types/cmap/trimap2.h>
 
 namespace cgogn
 {
 
+/////////////
+// TriMap2 //
+/////////////
+
+// the boundary dart that follows b in its hole starts at the vertex where phi2(b) starts:
+// it is found by turning around this vertex (inside the fan of triangles of phi2(b)) until the boundary is reached
+Dart boundary_phi1(const TriMap2& m, Dart b)
+{
+	Dart it = phi2(m, b);
+	if (it == b) // unused dart of a boundary triple
+		return b;
+	do
+	{
+		it = phi2(m, phi_1(m, it));
+	} while (!(*m.boundary_marker_)[it.index]);
+	return it;
+}
+
+// the boundary dart that precedes b in its hole ends at the vertex where phi2(b) ends
+Dart boundary_phi_1(const TriMap2& m, Dart b)
+{
+	Dart it = phi2(m, b);
+	if (it == b)
+		return b;
+	do
+	{
+		it = phi2(m, phi1(m, it));
+	} while (!(*m.boundary_marker_)[it.index]);
+	return it;
+}
+
+//////////
+// CPH3 //
+//////////
+
 Dart phi2bis(const CPH3& m, Dart d)
 {
 	const CPH3::CMAP& map = static_cast<const CPH3::CMAP&>(m);
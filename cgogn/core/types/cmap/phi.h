@@ -75,6 +75,34 @@ inline Dart alpha_1(const Graph& m, Dart d)
 	return (*m.alpha_1_)[d.index];
 }
 
+/////////////
+// TriMap2 //
+/////////////
+
+// phi1 / phi_1 of the boundary darts (that do not form triangles)
+Dart boundary_phi1(const TriMap2& m, Dart d);
+Dart boundary_phi_1(const TriMap2& m, Dart d);
+
+// forced inline: the out of line boundary calls would otherwise keep these functions out of the traversals loops
+CGOGN_ALWAYS_INLINE Dart phi1(const TriMap2& m, Dart d)
+{
+	if ((*m.boundary_marker_)[d.index])
+		return boundary_phi1(m, d);
+	return d.index % 3u == 2u ? Dart(d.index - 2u) : Dart(d.index + 1u);
+}
+
+CGOGN_ALWAYS_INLINE Dart phi_1(const TriMap2& m, Dart d)
+{
+	if ((*m.boundary_marker_)[d.index])
+		return boundary_phi_1(m, d);
+	return d.index % 3u == 0u ? Dart(d.index + 2u) : Dart(d.index - 1u);
+}
+
+inline Dart phi2(const TriMap2& m, Dart d)
+{
+	return (*(m.phi2_))[d.index];
+}
+
 //////////
 // CPH3 //
 //////////
@@ -124,6 +152,7 @@ inline Dart phi(const MESH& m, Dart d)
 template <typename MESH>
 auto phi1_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart f = phi1(m, d);
 	Dart g = phi1(m, e);
 	(*(m.phi1_))[d.index] = g;
@@ -135,6 +164,7 @@ auto phi1_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base
 template <typename MESH>
 auto phi1_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart e = phi1(m, d);
 	Dart f = phi1(m, e);
 	(*(m.phi1_))[d.index] = f;
@@ -146,6 +176,7 @@ auto phi1_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<
 template <typename MESH>
 auto phi2_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	cgogn_assert(phi2(m, d) == d);
 	cgogn_assert(phi2(m, e) == e);
 	(*(m.phi2_))[d.index] = e;
@@ -155,6 +186,7 @@ auto phi2_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base
 template <typename MESH>
 auto phi2_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart e = phi2(m, d);
 	(*(m.phi2_))[d.index] = d;
 	(*(m.phi2_))[e.index] = e;
@@ -163,6 +195,7 @@ auto phi2_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<
 template <typename MESH>
 auto phi3_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	cgogn_assert(phi3(m, d) == d);
 	cgogn_assert(phi3(m, e) == e);
 	(*(m.phi3_))[d.index] = e;
@@ -172,6 +205,7 @@ auto phi3_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base
 template <typename MESH>
 auto phi3_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart e = phi3(m, d);
 	(*(m.phi3_))[d.index] = d;
 	(*(m.phi3_))[e.index] = e;
@@ -180,6 +214,7 @@ auto phi3_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<
 template <typename MESH>
 auto alpha0_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	(*m.alpha0_)[d.index] = e;
 	(*m.alpha0_)[e.index] = d;
 }
@@ -187,6 +222,7 @@ auto alpha0_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_ba
 template <typename MESH>
 auto alpha0_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart e = alpha0(m, d);
 	(*m.alpha0_)[d.index] = d;
 	(*m.alpha0_)[e.index] = e;
@@ -195,6 +231,7 @@ auto alpha0_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_
 template <typename MESH>
 auto alpha1_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart f = alpha1(m, d);
 	Dart g = alpha1(m, e);
 	(*m.alpha1_)[d.index] = g;
@@ -206,6 +243,7 @@ auto alpha1_sew(MESH& m, Dart d, Dart e) -> typename std::enable_if_t<std::is_ba
 template <typename MESH>
 auto alpha1_unsew(MESH& m, Dart d) -> typename std::enable_if_t<std::is_base_of_v<CMapBase, MESH>>
 {
+	m.invalidate_nb_cells();
 	Dart e = alpha1(m, d);
 	Dart f = alpha_1(m, d);
 	(*m.alpha1_)[f.index] = e;
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_CORE_TYPES_CMAP_TRIMAP2_H_
+#define CGOGN_CORE_TYPES_CMAP_TRIMAP2_H_
+
+#include <cgogn/core/cgogn_core_export.h>
+
+#include <cgogn/core/types/cmap/cmap_base.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief 2-map of a pure triangle surface, with implicit phi1 / phi_1
+ * The darts of each triangle are allocated as a triple of consecutive indices starting at a multiple of 3, so
+ * phi1 and phi_1 are arithmetic inside the triple and only phi2 is stored.
+ * The boundary darts (that close the holes as in a CMap2) are also allocated by triples (with up to 2 unused
+ * darts per hole, marked as boundary and fixed points of phi1 / phi_1 / phi2). They do not form triangles: their
+ * phi1 / phi_1 are found by turning around the vertex (see phi.cpp), so boundary faces traversals cost the degree of
+ * their vertices.
+ * Darts are only created and released by whole triples (see add_triangle_darts): compact keeps the triples aligned,
+ * and the darts order given to CMapBase::reorder must move whole triples (see reorder_cells).
+ */
+struct CGOGN_CORE_EXPORT TriMap2 : public CMapBase
+{
+	static const uint8 dimension = 2;
+
+	using Vertex = Cell<PHI21>;
+	using HalfEdge = Cell<DART>;
+	using Edge = Cell<PHI2>;
+	using Face = Cell<PHI1>;
+	using Volume = Cell<PHI1_PHI2>;
+	using CC = Volume;
+
+	using Cells = std::tuple<Vertex, HalfEdge, Edge, Face, Volume>;
+
+	std::shared_ptr<Attribute<Dart>> phi2_;
+
+	TriMap2() : CMapBase()
+	{
+		phi2_ = add_relation("phi2");
+	}
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_CMAP_TRIMAP2_H_
@@ -25,6 +25,7 @@
 
 #include <cgogn/core/utils/assert.h>
 #include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/work_stealing.h>
 
 namespace cgogn
 {
@@ -34,7 +35,8 @@ namespace cgogn
 /////////////////////////
 
 AttributeGenT::AttributeGenT(AttributeContainerGen* container, const std::string& name)
-	: container_(container), name_(name)
+	: container_(container), name_(name), type_hash_(0u), version_(0u), all_modified_version_(0u),
+	  uncommitted_modifications_(false), nb_modification_stamps_(0u)
 {
 }
 
@@ -51,6 +53,34 @@ uint32 AttributeGenT::maximum_index() const
 	return 0;
 }
 
+void AttributeGenT::enable_modification_tracking()
+{
+	if (modification_stamps_)
+		return;
+	// the version of the untracked modifications is unknown: everything is modified
+	mark_all_modified();
+	const uint32 max = maximum_index();
+	resize_modification_stamps(max > 0u ? (max - 1u) / MODIFICATION_CHUNK_SIZE + 1u : 0u);
+}
+
+void AttributeGenT::disable_modification_tracking()
+{
+	modification_stamps_.reset();
+	nb_modification_stamps_ = 0u;
+}
+
+void AttributeGenT::resize_modification_stamps(uint32 nb_chunks)
+{
+	std::unique_ptr<std::atomic<uint64>[]> stamps(new std::atomic<uint64>[nb_chunks]);
+	const uint32 nb_kept = std::min(nb_chunks, nb_modification_stamps_);
+	for (uint32 c = 0u; c < nb_kept; ++c)
+		stamps[c].store(modification_stamps_[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	for (uint32 c = nb_kept; c < nb_chunks; ++c)
+		stamps[c].store(version_ + 1u, std::memory_order_relaxed);
+	modification_stamps_.swap(stamps);
+	nb_modification_stamps_ = nb_chunks;
+}
+
 /////////////////////////////////
 // AttributeContainerGen class //
 /////////////////////////////////
@@ -71,6 +101,7 @@ AttributeContainerGen::AttributeContainerGen() : nb_elements_(0), maximum_index_
 	}
 
 	available_indices_.reserve(1024);
+	occupancy_.reserve(1024);
 }
 
 AttributeContainerGen::~AttributeContainerGen()
@@ -93,8 +124,16 @@ uint32 AttributeContainerGen::new_index()
 	else
 		index = maximum_index_++;
 
+	const uint32 w = index / 64u;
+	if (w >= uint32(occupancy_.size()))
+		occupancy_.resize(w + 1u, 0u);
+	occupancy_[w] |= uint64(1) << (index % 64u);
+
 	for (AttributeGenT* ag : attributes_)
+	{
 		ag->manage_index(index);
+		ag->manage_modification_stamps(index);
+	}
 
 	{
 		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
@@ -112,33 +151,189 @@ uint32 AttributeContainerGen::new_index()
 	return index;
 }
 
+std::vector<uint32> AttributeContainerGen::new_indices(uint32 nb)
+{
+	std::vector<uint32> indices;
+	if (nb == 0u)
+		return indices;
+	indices.reserve(nb);
+	while (uint32(indices.size()) < nb && uint32(available_indices_.size()) > 0)
+	{
+		indices.push_back(available_indices_.back());
+		available_indices_.pop_back();
+	}
+	while (uint32(indices.size()) < nb)
+		indices.push_back(maximum_index_++);
+
+	occupancy_.resize((maximum_index_ + 63u) / 64u, 0u);
+	for (uint32 index : indices)
+		occupancy_[index / 64u] |= uint64(1) << (index % 64u);
+
+	for (AttributeGenT* ag : attributes_)
+	{
+		ag->manage_index(maximum_index_ - 1u);
+		ag->manage_modification_stamps(maximum_index_ - 1u);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
+		for (uint32 i = 0, nb_threads = uint32(mark_attributes_.size()); i < nb_threads; ++i)
+		{
+			for (AttributeGenT* ag : mark_attributes_[i])
+				ag->manage_index(maximum_index_ - 1u);
+		}
+		for (uint32 index : indices)
+			init_mark_attributes(index);
+	}
+
+	manage_ref_counter_index(maximum_index_ - 1u);
+	for (uint32 index : indices)
+		init_ref_counter(index);
+
+	nb_elements_ += nb;
+	return indices;
+}
+
 void AttributeContainerGen::release_index(uint32 index)
 {
 	cgogn_message_assert(nb_refs(index) > 0, "Trying to release an unused index");
 	available_indices_.push_back(index);
+	occupancy_[index / 64u] &= ~(uint64(1) << (index % 64u));
 	reset_ref_counter(index);
 	--nb_elements_;
 }
 
-void AttributeContainerGen::remove_attribute(const std::shared_ptr<AttributeGenT>& attribute)
+std::vector<uint32> AttributeContainerGen::compact()
+{
+	std::vector<uint32> old_new_indices(maximum_index_, INVALID_INDEX);
+	uint32 nb = 0u;
+	for (uint32 index = first_index(), end = last_index(); index != end; index = next_index(index))
+		old_new_indices[index] = nb++;
+	cgogn_message_assert(nb == nb_elements_, "Inconsistent number of elements");
+
+	for (AttributeGenT* ag : attributes_)
+	{
+		ag->compact(old_new_indices, nb);
+		ag->mark_all_modified();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
+		for (uint32 i = 0, nb_threads = uint32(mark_attributes_.size()); i < nb_threads; ++i)
+		{
+			for (AttributeGenT* ag : mark_attributes_[i])
+				ag->compact(old_new_indices, nb);
+		}
+	}
+
+	compact_ref_counter(old_new_indices, nb);
+
+	available_indices_.clear();
+	maximum_index_ = nb;
+	fill_occupancy();
+
+	return old_new_indices;
+}
+
+std::vector<uint32> AttributeContainerGen::reorder(const std::vector<uint32>& new_old_indices)
+{
+	const uint32 nb = uint32(new_old_indices.size());
+	cgogn_message_assert(nb == nb_elements_, "Inconsistent number of elements");
+
+	std::vector<uint32> old_new_indices(maximum_index_, INVALID_INDEX);
+	for (uint32 i = 0u; i < nb; ++i)
+	{
+		const uint32 old_index = new_old_indices[i];
+		cgogn_message_assert(is_used(old_index), "Reordering an unused index");
+		cgogn_message_assert(old_new_indices[old_index] == INVALID_INDEX, "Index given twice in the new order");
+		old_new_indices[old_index] = i;
+	}
+
+	for (AttributeGenT* ag : attributes_)
+	{
+		ag->permute(new_old_indices);
+		ag->mark_all_modified();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
+		for (uint32 i = 0, nb_threads = uint32(mark_attributes_.size()); i < nb_threads; ++i)
+		{
+			for (AttributeGenT* ag : mark_attributes_[i])
+				ag->permute(new_old_indices);
+		}
+	}
+
+	permute_ref_counter(new_old_indices);
+
+	available_indices_.clear();
+	maximum_index_ = nb;
+	fill_occupancy();
+
+	return old_new_indices;
+}
+
+void AttributeContainerGen::restore_indices(uint32 maximum_index, const std::vector<uint32>& available_indices)
 {
-	auto it = std::find(attributes_shared_ptr_.begin(), attributes_shared_ptr_.end(), attribute);
-	if (it != attributes_shared_ptr_.end())
+	maximum_index_ = maximum_index;
+	available_indices_ = available_indices;
+	nb_elements_ = maximum_index_ - uint32(available_indices_.size());
+
+	fill_occupancy();
+	for (uint32 index : available_indices_)
+		occupancy_[index / 64u] &= ~(uint64(1) << (index % 64u));
+
+	for (AttributeGenT* ag : attributes_)
 	{
-		*it = attributes_shared_ptr_.back();
-		attributes_shared_ptr_.pop_back();
+		ag->manage_index(maximum_index_);
+		ag->manage_modification_stamps(maximum_index_);
+		ag->mark_all_modified();
 	}
+
+	{
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
+		for (uint32 i = 0, nb = uint32(mark_attributes_.size()); i < nb; ++i)
+		{
+			for (AttributeGenT* ag : mark_attributes_[i])
+				ag->manage_index(maximum_index_);
+		}
+	}
+
+	manage_ref_counter_index(maximum_index_);
+}
+
+void AttributeContainerGen::register_attribute(const std::shared_ptr<AttributeGenT>& attribute)
+{
+	attributes_positions_.emplace(attribute->name(), uint32(attributes_shared_ptr_.size()));
+	attributes_shared_ptr_.push_back(attribute);
+}
+
+void AttributeContainerGen::remove_attribute(const std::shared_ptr<AttributeGenT>& attribute)
+{
+	remove_attribute(attribute.get());
 }
 
 void AttributeContainerGen::remove_attribute(AttributeGenT* attribute)
 {
-	auto it = std::find_if(attributes_shared_ptr_.begin(), attributes_shared_ptr_.end(),
-						   [&](const auto& att) { return att.get() == attribute; });
-	if (it != attributes_shared_ptr_.end())
+	auto it = attributes_positions_.find(attribute->name());
+	if (it == attributes_positions_.end() || attributes_shared_ptr_[it->second].get() != attribute)
+		return;
+	// the last attribute takes the place of the removed one
+	const uint32 position = it->second;
+	attributes_positions_.erase(it);
+	if (position != uint32(attributes_shared_ptr_.size()) - 1u)
 	{
-		*it = attributes_shared_ptr_.back();
-		attributes_shared_ptr_.pop_back();
+		attributes_shared_ptr_[position] = std::move(attributes_shared_ptr_.back());
+		attributes_positions_[attributes_shared_ptr_[position]->name()] = position;
 	}
+	attributes_shared_ptr_.pop_back();
+}
+
+void AttributeContainerGen::fill_occupancy()
+{
+	occupancy_.assign(maximum_index_ / 64u, ~uint64(0));
+	if (maximum_index_ % 64u != 0u)
+		occupancy_.push_back((uint64(1) << (maximum_index_ % 64u)) - 1u);
 }
 
 void AttributeContainerGen::delete_attribute(AttributeGenT* attribute)
@@ -151,4 +346,120 @@ void AttributeContainerGen::delete_attribute(AttributeGenT* attribute)
 	}
 }
 
+AttributeContainerGen::MemoryReport AttributeContainerGen::memory_report() const
+{
+	MemoryReport report;
+	report.nb_elements = nb_elements_;
+	report.maximum_index = maximum_index_;
+	report.capacity = ref_counter().capacity();
+	report.nb_available_indices = uint32(available_indices_.size());
+
+	// attributes removed from the container but still referenced elsewhere are also counted
+	report.attributes.reserve(attributes_.size());
+	for (const AttributeGenT* ag : attributes_)
+		report.attributes.push_back({ag->name(), ag->capacity(), ag->memory_size()});
+
+	{
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
+		for (uint32 i = 0, nb = uint32(mark_attributes_.size()); i < nb; ++i)
+		{
+			report.nb_mark_attributes += uint32(mark_attributes_[i].size());
+			report.nb_available_mark_attributes += uint32(available_mark_attributes_[i].size());
+			for (const AttributeGenT* ag : mark_attributes_[i])
+				report.mark_attributes_bytes += ag->memory_size();
+		}
+	}
+
+	report.bookkeeping_bytes =
+		ref_counter().memory_size() + occupancy_.capacity() * sizeof(uint64) +
+		available_indices_.capacity() * sizeof(uint32) + attributes_.capacity() * sizeof(AttributeGenT*) +
+		attributes_shared_ptr_.capacity() * sizeof(std::shared_ptr<AttributeGenT>) +
+		attributes_positions_.bucket_count() * sizeof(void*) +
+		attributes_positions_.size() * (sizeof(std::pair<const std::string, uint32>) + 2u * sizeof(void*));
+
+	return report;
+}
+
+std::size_t AttributeContainerGen::MemoryReport::attributes_bytes() const
+{
+	std::size_t bytes = 0u;
+	for (const AttributeMemory& a : attributes)
+		bytes += a.bytes;
+	return bytes;
+}
+
+std::size_t AttributeContainerGen::MemoryReport::total_bytes() const
+{
+	return attributes_bytes() + mark_attributes_bytes + bookkeeping_bytes;
+}
+
+float64 AttributeContainerGen::MemoryReport::fragmentation() const
+{
+	return maximum_index > 0u ? float64(nb_available_indices) / float64(maximum_index) : 0.0;
+}
+
+float64 AttributeContainerGen::MemoryReport::unused_capacity() const
+{
+	return capacity > 0u ? float64(capacity - nb_elements) / float64(capacity) : 0.0;
+}
+
+/////////////////////
+// MarkArray class //
+/////////////////////
+
+void MarkArray::add_dirty_chunk(uint32 chunk)
+{
+	dirty_[chunk] = 1u;
+	dirty_chunks_.push_back(chunk);
+}
+
+void MarkArray::permute(const std::vector<uint32>& new_old_indices)
+{
+	const uint32 nb_elements = uint32(new_old_indices.size());
+	const uint32 nb_chunks = (nb_elements + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+	std::vector<uint64*> chunks(nb_chunks);
+	std::vector<uint8> dirty(nb_chunks, 0u);
+	// ranges are made of whole chunks, so that no word is written by two threads
+	parallel_foreach_range(
+		0u, nb_elements,
+		[&](uint32 begin, uint32 end) {
+			for (uint32 c = begin / CHUNK_SIZE; c * CHUNK_SIZE < end; ++c)
+				chunks[c] = new uint64[CHUNK_NB_WORDS]();
+			// most mark attributes are not in use (all false): nothing to move
+			if (dirty_chunks_.empty())
+				return;
+			for (uint32 i = begin; i < end; ++i)
+			{
+				if ((*this)[new_old_indices[i]])
+				{
+					chunks[i / CHUNK_SIZE][(i % CHUNK_SIZE) / 64u] |= uint64(1) << (i % 64u);
+					dirty[i / CHUNK_SIZE] = 1u;
+				}
+			}
+		},
+		CHUNK_SIZE);
+
+	for (uint64* c : chunks_)
+		delete[] c;
+	chunks_.swap(chunks);
+	dirty_.swap(dirty);
+	dirty_chunks_.clear();
+	for (uint32 c = 0u; c < nb_chunks; ++c)
+	{
+		if (dirty_[c])
+			dirty_chunks_.push_back(c);
+	}
+	capacity_ = nb_chunks * CHUNK_SIZE;
+}
+
+void MarkArray::all_false()
+{
+	for (uint32 chunk : dirty_chunks_)
+	{
+		std::fill(chunks_[chunk], chunks_[chunk] + CHUNK_NB_WORDS, uint64(0));
+		dirty_[chunk] = 0u;
+	}
+	dirty_chunks_.clear();
+}
+
 } // namespace cgogn
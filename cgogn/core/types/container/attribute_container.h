@@ -28,10 +28,14 @@
 
 #include <cgogn/core/utils/numerics.h>
 #include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/type_traits.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cgogn
@@ -41,6 +45,58 @@ class AttributeContainerGen;
 template <template <typename> class AttributeT>
 class AttributeContainerT;
 
+namespace internal
+{
+
+// bytes of heap memory owned by a value (not counting sizeof the value itself)
+template <typename T>
+std::size_t heap_size(const T&);
+inline std::size_t heap_size(const std::string& s);
+template <typename T>
+std::size_t heap_size(const std::vector<T>& v);
+
+template <typename T>
+std::size_t heap_size(const T&)
+{
+	return 0u;
+}
+
+inline std::size_t heap_size(const std::string& s)
+{
+	// short strings are stored in the object itself
+	const char* begin = reinterpret_cast<const char*>(&s);
+	if (s.data() >= begin && s.data() < begin + sizeof(std::string))
+		return 0u;
+	return s.capacity() + 1u;
+}
+
+template <typename T>
+std::size_t heap_size(const std::vector<T>& v)
+{
+	std::size_t size = v.capacity() * sizeof(T);
+	if constexpr (!std::is_trivially_copyable_v<T>)
+	{
+		for (const T& x : v)
+			size += heap_size(x);
+	}
+	return size;
+}
+
+// bytes of heap memory owned by the values [begin, end)
+template <typename T>
+std::size_t heap_size(const T* begin, const T* end)
+{
+	std::size_t size = 0u;
+	if constexpr (!std::is_trivially_copyable_v<T>)
+	{
+		for (const T* it = begin; it != end; ++it)
+			size += heap_size(*it);
+	}
+	return size;
+}
+
+} // namespace internal
+
 /////////////////////////
 // AttributeGenT class //
 /////////////////////////
@@ -56,18 +112,155 @@ public:
 		return name_;
 	}
 
+	// type_hash of the type of the values (0 if the attribute was not created by a container)
+	inline uint64 type_hash() const
+	{
+		return type_hash_;
+	}
+
+	template <typename T>
+	inline bool is_of_type() const
+	{
+		return type_hash_ == cgogn::type_hash<T>();
+	}
+
 	uint32 maximum_index() const;
 
+	inline bool is_used(uint32 index) const;
+
+	// number of elements for which values are allocated
+	virtual uint32 capacity() const = 0;
+	// bytes allocated by the attribute (values, heap memory owned by the values and modification stamps)
+	virtual std::size_t memory_size() const = 0;
+
+	/**
+	 * Modification tracking
+	 * The version of an attribute is incremented by each commit_modifications() (i.e. at the end of each writing
+	 * phase). When tracking is enabled, the indices are grouped by chunks of MODIFICATION_CHUNK_SIZE and each chunk
+	 * holds the version at which it was last modified: a writer reports a modified element with mark_modified (a
+	 * relaxed atomic store at most once per chunk and per version, so it can be called concurrently) and each
+	 * consumer, remembering the version it is synchronized with, only processes the chunks modified since then.
+	 * Without tracking, every commit makes the whole attribute modified.
+	 * Tracking is not automatic: writers of a tracked attribute have to mark the elements they modify.
+	 */
+	static const uint32 MODIFICATION_CHUNK_SIZE = 1024u;
+
+	void enable_modification_tracking();
+	void disable_modification_tracking();
+
+	inline bool is_modification_tracked() const
+	{
+		return modification_stamps_ != nullptr;
+	}
+
+	inline uint64 version() const
+	{
+		return version_;
+	}
+
+	CGOGN_ALWAYS_INLINE void mark_modified(uint32 index)
+	{
+		if (modification_stamps_)
+		{
+			cgogn_message_assert(index / MODIFICATION_CHUNK_SIZE < nb_modification_stamps_, "index out of bounds");
+			std::atomic<uint64>& stamp = modification_stamps_[index / MODIFICATION_CHUNK_SIZE];
+			if (stamp.load(std::memory_order_relaxed) != version_ + 1u)
+			{
+				stamp.store(version_ + 1u, std::memory_order_relaxed);
+				uncommitted_modifications_.store(true, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	inline void mark_all_modified()
+	{
+		all_modified_version_ = version_ + 1u;
+		uncommitted_modifications_.store(true, std::memory_order_relaxed);
+	}
+
+	// true if some elements were marked as modified since the last commit
+	inline bool has_uncommitted_modifications() const
+	{
+		return uncommitted_modifications_.load(std::memory_order_relaxed);
+	}
+
+	// must not be called concurrently with writers: the marks that follow belong to the next version
+	inline uint64 commit_modifications()
+	{
+		uncommitted_modifications_.store(false, std::memory_order_relaxed);
+		return ++version_;
+	}
+
+	/**
+	 * @brief call f(begin, end) on the maximal ranges of indices (clipped to maximum_index) that may have been
+	 * modified after the given version (committed or not)
+	 */
+	template <typename FUNC>
+	void foreach_modified_range(uint64 since_version, const FUNC& f) const
+	{
+		static_assert(is_func_parameter_same<FUNC, uint32>::value, "Wrong function parameter type");
+		const uint32 end = maximum_index();
+		if (all_modified_version_ > since_version || (!modification_stamps_ && version_ > since_version))
+		{
+			if (end > 0u)
+				f(0u, end);
+			return;
+		}
+		if (!modification_stamps_)
+			return;
+		const uint32 nb_chunks = std::min(nb_modification_stamps_, (end + MODIFICATION_CHUNK_SIZE - 1u) /
+																		   MODIFICATION_CHUNK_SIZE);
+		uint32 c = 0u;
+		while (c < nb_chunks)
+		{
+			if (modification_stamps_[c].load(std::memory_order_relaxed) <= since_version)
+			{
+				++c;
+				continue;
+			}
+			const uint32 first = c;
+			while (c < nb_chunks && modification_stamps_[c].load(std::memory_order_relaxed) > since_version)
+				++c;
+			f(first * MODIFICATION_CHUNK_SIZE, std::min(c * MODIFICATION_CHUNK_SIZE, end));
+		}
+	}
+
 protected:
 	AttributeContainerGen* container_;
 	std::string name_;
+	uint64 type_hash_;
+
+	inline std::size_t modification_stamps_memory_size() const
+	{
+		return modification_stamps_ ? nb_modification_stamps_ * sizeof(std::atomic<uint64>) : 0u;
+	}
 
 private:
 	friend AttributeContainerGen;
 	template <template <typename> class AttributeT>
 	friend class AttributeContainerT;
 
+	uint64 version_;
+	uint64 all_modified_version_;
+	std::atomic<bool> uncommitted_modifications_;
+	std::unique_ptr<std::atomic<uint64>[]> modification_stamps_;
+	uint32 nb_modification_stamps_;
+
+	// new elements are modified elements
+	inline void manage_modification_stamps(uint32 index)
+	{
+		if (modification_stamps_ && index / MODIFICATION_CHUNK_SIZE >= nb_modification_stamps_)
+			resize_modification_stamps(index / MODIFICATION_CHUNK_SIZE + 1u);
+	}
+	void resize_modification_stamps(uint32 nb_chunks);
+
 	virtual void manage_index(uint32 index) = 0;
+	// move each element i to old_new_indices[i] (always <= i, INVALID_INDEX for unused indices)
+	// and release the memory beyond the nb_elements first elements
+	virtual void compact(const std::vector<uint32>& old_new_indices, uint32 nb_elements) = 0;
+	// rebuild the attribute with new_old_indices.size() elements,
+	// element i taking the value of the element new_old_indices[i]
+	virtual void permute(const std::vector<uint32>& new_old_indices) = 0;
 };
 
 /////////////////////////////////
@@ -92,6 +285,42 @@ public:
 	uint32 new_index();
 	void release_index(uint32 index);
 
+	/**
+	 * @brief get nb new indices at once: the same indices, in the same order, as nb successive calls to new_index
+	 * Attributes are grown once for all the new indices, which can then be filled concurrently by several threads.
+	 */
+	std::vector<uint32> new_indices(uint32 nb);
+
+	/**
+	 * @brief renumber the used indices contiguously (preserving their order) and shrink all attributes
+	 * Values of all attributes (including mark attributes and reference counters) follow their element.
+	 * @return the old-to-new index mapping (INVALID_INDEX for the indices that were not used)
+	 */
+	std::vector<uint32> compact();
+
+	/**
+	 * @brief renumber the used indices in the given order: the element of index new_old_indices[i] gets index i
+	 * new_old_indices must list each used index exactly once. As with compact, the attributes are rebuilt
+	 * contiguously and values of all attributes (including mark attributes and reference counters) follow
+	 * their element.
+	 * @return the old-to-new index mapping (INVALID_INDEX for the indices that were not used)
+	 */
+	std::vector<uint32> reorder(const std::vector<uint32>& new_old_indices);
+
+	// released indices, reused (from the back) by the next calls to new_index
+	inline const std::vector<uint32>& available_indices() const
+	{
+		return available_indices_;
+	}
+
+	/**
+	 * @brief set the indices state of the container (e.g. when loaded from a file)
+	 * All indices below maximum_index that are not in available_indices are considered used.
+	 * Attributes are extended to maximum_index; the values of the attributes and of the reference counter
+	 * have to be restored by the caller.
+	 */
+	void restore_indices(uint32 maximum_index, const std::vector<uint32>& available_indices);
+
 	void remove_attribute(const std::shared_ptr<AttributeGenT>& attribute);
 	void remove_attribute(AttributeGenT* attribute);
 
@@ -107,10 +336,7 @@ public:
 
 	inline uint32 first_index() const
 	{
-		uint32 index = 0u;
-		while (index < maximum_index_ && nb_refs(index) == 0)
-			++index;
-		return index;
+		return used_index_from(0u);
 	}
 
 	inline uint32 last_index() const
@@ -120,23 +346,73 @@ public:
 
 	inline uint32 next_index(uint32 index) const
 	{
-		do
-		{
-			++index;
-		} while (index < maximum_index_ && nb_refs(index) == 0);
-		return index;
+		return used_index_from(index + 1u);
+	}
+
+	inline bool is_used(uint32 index) const
+	{
+		const uint32 w = index / 64u;
+		return w < uint32(occupancy_.size()) && (occupancy_[w] & (uint64(1) << (index % 64u))) != 0u;
 	}
 
+	/**
+	 * Memory footprint of a container
+	 * Indices in [0, maximum_index) are either used (nb_elements) or released (nb_available_indices) and values
+	 * are allocated for capacity elements. The released indices are the holes that compact() would remove.
+	 */
+	struct AttributeMemory
+	{
+		std::string name;
+		uint32 capacity;
+		std::size_t bytes;
+	};
+
+	struct MemoryReport
+	{
+		uint32 nb_elements = 0u;
+		uint32 maximum_index = 0u;
+		uint32 capacity = 0u;
+		uint32 nb_available_indices = 0u;
+
+		std::vector<AttributeMemory> attributes;
+
+		// pooled mark attributes of all threads (available ones are not currently used by a marker)
+		uint32 nb_mark_attributes = 0u;
+		uint32 nb_available_mark_attributes = 0u;
+		std::size_t mark_attributes_bytes = 0u;
+
+		// reference counter, occupancy bits, free list and attributes index
+		std::size_t bookkeeping_bytes = 0u;
+
+		std::size_t attributes_bytes() const;
+		std::size_t total_bytes() const;
+
+		// ratio of the index range made of released indices
+		float64 fragmentation() const;
+		// ratio of the allocated elements that are not used
+		float64 unused_capacity() const;
+	};
+
+	// other threads may get and release marks meanwhile, but must not add attributes or indices
+	MemoryReport memory_report() const;
+
 protected:
 	std::vector<AttributeGenT*> attributes_;
 	std::vector<std::shared_ptr<AttributeGenT>> attributes_shared_ptr_;
+	// position in attributes_shared_ptr_ of each attribute, by name
+	std::unordered_map<std::string, uint32> attributes_positions_;
 
-	std::mutex mark_attributes_mutex_;
+	mutable std::mutex mark_attributes_mutex_;
 	std::vector<std::vector<AttributeGenT*>> mark_attributes_;
 	std::vector<std::vector<uint32>> available_mark_attributes_;
 
 	std::vector<uint32> available_indices_;
 
+	// one bit per index, set if the index is in use (no bit is set beyond maximum_index_)
+	std::vector<uint64> occupancy_;
+	// number of used indices from which an occupancy word is scanned slot by slot (see used_index_from)
+	static const uint32 DENSE_OCCUPANCY_WORD = 32u;
+
 	uint32 nb_elements_;
 	uint32 maximum_index_;
 
@@ -144,12 +420,214 @@ protected:
 
 	void delete_attribute(AttributeGenT* attribute);
 
+	// registered attribute of the given name (nullptr if none)
+	inline const std::shared_ptr<AttributeGenT>* find_attribute(const std::string& name) const
+	{
+		auto it = attributes_positions_.find(name);
+		return it != attributes_positions_.end() ? &attributes_shared_ptr_[it->second] : nullptr;
+	}
+
+	void register_attribute(const std::shared_ptr<AttributeGenT>& attribute);
+
+	// mark indices [0, maximum_index_) as used and all others as unused
+	void fill_occupancy();
+
+	// first used index >= index (maximum_index_ if none)
+	inline uint32 used_index_from(uint32 index) const
+	{
+		uint32 w = index / 64u;
+		const uint32 nb_words = uint32(occupancy_.size());
+		if (w < nb_words)
+		{
+			const uint64 word = occupancy_[w] >> (index % 64u);
+			// dense case first: this branch is well predicted and keeps the loop free of ctz latency
+			if ((word & 1u) != 0u)
+				return index;
+			if (word != 0u)
+			{
+				// in a dense word, testing the slots one by one lets the next index be predicted instead of
+				// waiting for the word load and the ctz (faster on regular patterns like alternate slots)
+				if (count_ones(occupancy_[w]) >= DENSE_OCCUPANCY_WORD)
+				{
+					uint32 offset = 1u;
+					while (((word >> offset) & 1u) == 0u)
+						++offset;
+					return index + offset;
+				}
+				return index + count_trailing_zeros(word);
+			}
+			while (++w < nb_words)
+			{
+				if (occupancy_[w] != 0u)
+					return w * 64u + count_trailing_zeros(occupancy_[w]);
+			}
+		}
+		return maximum_index_;
+	}
+
 	virtual void init_ref_counter(uint32 index) = 0;
 	virtual void reset_ref_counter(uint32 index) = 0;
+	virtual void compact_ref_counter(const std::vector<uint32>& old_new_indices, uint32 nb_elements) = 0;
+	virtual void permute_ref_counter(const std::vector<uint32>& new_old_indices) = 0;
+	virtual void manage_ref_counter_index(uint32 index) = 0;
 	virtual uint32 nb_refs(uint32 index) const = 0;
+	virtual const AttributeGenT& ref_counter() const = 0;
 	virtual void init_mark_attributes(uint32 index) = 0;
 };
 
+inline bool AttributeGenT::is_used(uint32 index) const
+{
+	return container_ && container_->is_used(index);
+}
+
+/////////////////////
+// MarkArray class //
+/////////////////////
+
+/**
+ * @brief boolean attribute with one bit per element, used for the marks of the markers and the boundary darts
+ * Bits are stored by chunks of CHUNK_SIZE elements. The chunks in which a bit has been set since the last
+ * all_false() are listed, so that all_false() only clears these chunks (its cost is proportional to the
+ * number of marked elements, not to the size of the container) and reading a mark is a single bit test.
+ * As 64 elements share a word, marks of a same MarkArray must not be set concurrently by several threads.
+ */
+class CGOGN_CORE_EXPORT MarkArray : public AttributeGenT
+{
+public:
+	static const uint32 CHUNK_SIZE = 1024u;
+	static const uint32 CHUNK_NB_WORDS = CHUNK_SIZE / 64u;
+
+private:
+	std::vector<uint64*> chunks_;
+	std::vector<uint8> dirty_;
+	std::vector<uint32> dirty_chunks_;
+	uint32 capacity_;
+
+	inline void manage_index(uint32 index) override
+	{
+		while (index >= capacity_)
+		{
+			chunks_.push_back(new uint64[CHUNK_NB_WORDS]());
+			dirty_.push_back(0u);
+			capacity_ = uint32(chunks_.size()) * CHUNK_SIZE;
+		}
+	}
+
+	inline void compact(const std::vector<uint32>& old_new_indices, uint32 nb_elements) override
+	{
+		for (uint32 i = 0, end = uint32(old_new_indices.size()); i < end; ++i)
+		{
+			uint32 new_index = old_new_indices[i];
+			if (new_index != INVALID_INDEX && new_index != i)
+				set_value(new_index, (*this)[i]);
+		}
+		uint32 nb_chunks = (nb_elements + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		while (uint32(chunks_.size()) > nb_chunks)
+		{
+			delete[] chunks_.back();
+			chunks_.pop_back();
+		}
+		dirty_.resize(nb_chunks);
+		dirty_chunks_.erase(std::remove_if(dirty_chunks_.begin(), dirty_chunks_.end(),
+										   [&](uint32 chunk) { return chunk >= nb_chunks; }),
+							dirty_chunks_.end());
+		capacity_ = uint32(chunks_.size()) * CHUNK_SIZE;
+	}
+
+	void permute(const std::vector<uint32>& new_old_indices) override;
+
+	// out of line to keep the fast paths small
+	void add_dirty_chunk(uint32 chunk);
+
+	CGOGN_ALWAYS_INLINE uint64* dirty_words(uint32 chunk)
+	{
+		if (!dirty_[chunk])
+			add_dirty_chunk(chunk);
+		return chunks_[chunk];
+	}
+
+public:
+	MarkArray(AttributeContainerGen* container, const std::string& name) : AttributeGenT(container, name)
+	{
+		chunks_.reserve(512u);
+		dirty_.reserve(512u);
+		dirty_chunks_.reserve(512u);
+		capacity_ = 0u;
+	}
+
+	~MarkArray() override
+	{
+		for (uint64* c : chunks_)
+			delete[] c;
+	}
+
+	CGOGN_ALWAYS_INLINE bool operator[](uint32 index) const
+	{
+		cgogn_message_assert(index < capacity_, "index out of bounds");
+		return (chunks_[index / CHUNK_SIZE][(index % CHUNK_SIZE) / 64u] >> (index % 64u)) & 1u;
+	}
+
+	CGOGN_ALWAYS_INLINE void set_true(uint32 index)
+	{
+		cgogn_message_assert(index < capacity_, "index out of bounds");
+		dirty_words(index / CHUNK_SIZE)[(index % CHUNK_SIZE) / 64u] |= uint64(1) << (index % 64u);
+	}
+
+	CGOGN_ALWAYS_INLINE void set_false(uint32 index)
+	{
+		cgogn_message_assert(index < capacity_, "index out of bounds");
+		chunks_[index / CHUNK_SIZE][(index % CHUNK_SIZE) / 64u] &= ~(uint64(1) << (index % 64u));
+	}
+
+	inline void set_value(uint32 index, bool b)
+	{
+		if (b)
+			set_true(index);
+		else
+			set_false(index);
+	}
+
+	/**
+	 * @brief set all the bits to false (only the chunks in which a bit was set are cleared)
+	 */
+	void all_false();
+
+	inline uint32 nb_chunks() const
+	{
+		return uint32(chunks_.size());
+	}
+
+	inline uint32 nb_dirty_chunks() const
+	{
+		return uint32(dirty_chunks_.size());
+	}
+
+	inline uint32 capacity() const override
+	{
+		return capacity_;
+	}
+
+	inline std::size_t memory_size() const override
+	{
+		return chunks_.size() * CHUNK_NB_WORDS * sizeof(uint64) + chunks_.capacity() * sizeof(uint64*) +
+			   dirty_.capacity() * sizeof(uint8) + dirty_chunks_.capacity() * sizeof(uint32) +
+			   modification_stamps_memory_size();
+	}
+
+	/**
+	 * @brief the CHUNK_NB_WORDS words of a chunk (element i of the chunk is bit i % 64 of word i / 64)
+	 */
+	inline const uint64* chunk_words(uint32 chunk) const
+	{
+		return chunks_[chunk];
+	}
+
+	inline uint64* chunk_words(uint32 chunk)
+	{
+		return dirty_words(chunk);
+	}
+};
+
 ///////////////////////////////
 // AttributeContainerT class //
 ///////////////////////////////
@@ -161,7 +639,7 @@ public:
 	template <typename T>
 	using Attribute = AttributeT<T>;
 	using AttributeGen = AttributeGenT;
-	using MarkAttribute = Attribute<uint8>;
+	using MarkAttribute = MarkArray;
 
 public:
 	std::unique_ptr<Attribute<uint32>> ref_counter_;
@@ -178,11 +656,31 @@ public:
 		(*ref_counter_)[index] = 0u;
 	}
 
+	inline void compact_ref_counter(const std::vector<uint32>& old_new_indices, uint32 nb_elements) override
+	{
+		static_cast<AttributeGenT*>(ref_counter_.get())->compact(old_new_indices, nb_elements);
+	}
+
+	inline void permute_ref_counter(const std::vector<uint32>& new_old_indices) override
+	{
+		static_cast<AttributeGenT*>(ref_counter_.get())->permute(new_old_indices);
+	}
+
+	inline void manage_ref_counter_index(uint32 index) override
+	{
+		static_cast<AttributeGenT*>(ref_counter_.get())->manage_index(index);
+	}
+
 	inline uint32 nb_refs(uint32 index) const override
 	{
 		return (*ref_counter_)[index];
 	}
 
+	inline const AttributeGenT& ref_counter() const override
+	{
+		return *ref_counter_;
+	}
+
 	inline void init_mark_attributes(uint32 index) override
 	{
 		for (uint32 i = 0, nb = uint32(mark_attributes_.size()); i < nb; ++i)
@@ -190,7 +688,7 @@ public:
 			for (AttributeGenT* mark_attribute : mark_attributes_[i])
 			{
 				MarkAttribute* m = static_cast<MarkAttribute*>(mark_attribute);
-				(*m)[index] = 0u;
+				m->set_false(index);
 			}
 		}
 	}
@@ -205,37 +703,39 @@ public:
 	{
 	}
 
+	// attributes are registered by name in a hash table: add_attribute and get_attribute do not depend on the
+	// number of attributes of the container (the returned shared pointers can also be kept to avoid the lookup)
 	template <typename T>
 	std::shared_ptr<Attribute<T>> add_attribute(const std::string& name)
 	{
-		auto it = std::find_if(attributes_.begin(), attributes_.end(),
-							   [&](AttributeGenT* att) { return att->name().compare(name) == 0; });
-		if (it == attributes_.end())
-		{
-			std::shared_ptr<Attribute<T>> asp = std::make_shared<Attribute<T>>(this, name);
-			Attribute<T>* ap = asp.get();
-			// AttributeContainerT is friend of AttributeGenT
-			static_cast<AttributeGenT*>(ap)->manage_index(maximum_index_);
-			attributes_.push_back(ap);
-			attributes_shared_ptr_.push_back(asp);
-			return asp;
-		}
-		return std::shared_ptr<Attribute<T>>();
+		if (find_attribute(name))
+			return std::shared_ptr<Attribute<T>>();
+		std::shared_ptr<Attribute<T>> asp = std::make_shared<Attribute<T>>(this, name);
+		Attribute<T>* ap = asp.get();
+		// AttributeContainerT is friend of AttributeGenT
+		static_cast<AttributeGenT*>(ap)->type_hash_ = type_hash<T>();
+		static_cast<AttributeGenT*>(ap)->manage_index(maximum_index_);
+		attributes_.push_back(ap);
+		register_attribute(asp);
+		return asp;
 	}
 
+	// the attribute of the given name if its values are of type T (no RTTI is used)
 	template <typename T>
 	std::shared_ptr<Attribute<T>> get_attribute(const std::string& name) const
 	{
-		auto it = std::find_if(attributes_shared_ptr_.begin(), attributes_shared_ptr_.end(),
-							   [&](const auto& att) { return att->name().compare(name) == 0; });
-		if (it != attributes_shared_ptr_.end())
-			return std::dynamic_pointer_cast<Attribute<T>>(*it);
+		const std::shared_ptr<AttributeGenT>* a = find_attribute(name);
+		if (a && (*a)->is_of_type<T>())
+			return std::static_pointer_cast<Attribute<T>>(*a);
 		return std::shared_ptr<Attribute<T>>();
 	}
 
+	// the per-thread pools are only modified under mark_attributes_mutex_, so that the index management and
+	// memory_report can go through all of them while other threads get or release their marks
 	MarkAttribute* get_mark_attribute()
 	{
 		uint32 thread_index = current_thread_index();
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
 		if (available_mark_attributes_[thread_index].size() > 0)
 		{
 			uint32 index = available_mark_attributes_[thread_index].back();
@@ -255,6 +755,7 @@ public:
 	void release_mark_attribute(MarkAttribute* attribute)
 	{
 		uint32 thread_index = current_thread_index();
+		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
 		auto it = std::find(mark_attributes_[thread_index].begin(), mark_attributes_[thread_index].end(), attribute);
 		cgogn_message_assert(it != mark_attributes_[thread_index].end(), "Mark Attribute not found on release");
 		available_mark_attributes_[thread_index].push_back(
@@ -0,0 +1,284 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#include <cgogn/core/types/container/chunk_allocator.h>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cgogn
+{
+
+namespace
+{
+
+const std::size_t CACHE_LINE_SIZE = 64u;
+const std::size_t HUGE_PAGE_SIZE = std::size_t(2u) << 20u;
+const std::size_t ARENA_SIZE = 16u * HUGE_PAGE_SIZE;
+
+#ifdef __linux__
+
+// set of the online NUMA nodes as a mbind node mask (empty if the system has a single node)
+std::vector<unsigned long> online_nodes_mask()
+{
+	std::vector<unsigned long> mask;
+	std::ifstream file("/sys/devices/system/node/online");
+	std::string ranges;
+	if (!file.good() || !std::getline(file, ranges))
+		return mask;
+	const std::size_t bits = 8u * sizeof(unsigned long);
+	std::size_t pos = 0u;
+	while (pos < ranges.size())
+	{
+		std::size_t end = ranges.find(',', pos);
+		if (end == std::string::npos)
+			end = ranges.size();
+		const std::string range = ranges.substr(pos, end - pos);
+		const std::size_t dash = range.find('-');
+		const unsigned long first = std::stoul(range.substr(0u, dash));
+		const unsigned long last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1u));
+		for (unsigned long n = first; n <= last; ++n)
+		{
+			if (mask.size() <= n / bits)
+				mask.resize(n / bits + 1u, 0ul);
+			mask[n / bits] |= 1ul << (n % bits);
+		}
+		pos = end + 1u;
+	}
+	if (mask.size() == 1u && (mask[0] & (mask[0] - 1ul)) == 0ul)
+		mask.clear();
+	return mask;
+}
+
+void* map_arena(ChunkPlacement placement)
+{
+	// over-map to align the arena on its size (and thus on a huge page boundary)
+	const std::size_t mapped_size = 2u * ARENA_SIZE;
+	void* m = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (m == MAP_FAILED)
+		return nullptr;
+	const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(m);
+	const std::uintptr_t aligned = (begin + ARENA_SIZE - 1u) & ~(ARENA_SIZE - 1u);
+	if (aligned > begin)
+		munmap(m, aligned - begin);
+	if (aligned + ARENA_SIZE < begin + mapped_size)
+		munmap(reinterpret_cast<void*>(aligned + ARENA_SIZE), begin + mapped_size - aligned - ARENA_SIZE);
+	void* arena = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+	madvise(arena, ARENA_SIZE, MADV_HUGEPAGE);
+#endif
+	if (placement == ChunkPlacement::INTERLEAVE)
+	{
+		static const std::vector<unsigned long> nodes = online_nodes_mask();
+		// MPOL_INTERLEAVE; failure (no NUMA support in the kernel) leaves the default local policy
+		if (!nodes.empty())
+			syscall(SYS_mbind, arena, ARENA_SIZE, 3, nodes.data(), nodes.size() * 8u * sizeof(unsigned long) + 1u,
+					0u);
+	}
+	return arena;
+}
+
+#else
+
+void* map_arena(ChunkPlacement)
+{
+	return ::operator new(ARENA_SIZE, std::align_val_t(ARENA_SIZE), std::nothrow);
+}
+
+#endif
+
+// arenas are aligned on their size: the arena of a chunk is found by masking its address
+// the bases of the arenas are stored in a fixed open addressing table that is read without lock
+// (arenas are never unmapped, slots are only filled, under the mutex)
+const uint32 MAX_NB_ARENAS = 4096u;
+const uint32 ARENA_TABLE_SIZE = 2u * MAX_NB_ARENAS;
+
+struct ChunkArenas
+{
+	// the policy fields are read without lock (by every chunk allocation)
+	std::atomic<bool> huge_page_arenas_{false};
+	std::atomic<ChunkPlacement> placement_{ChunkPlacement::LOCAL};
+	std::atomic<bool> parallel_first_touch_{true};
+
+	std::atomic<uint32> nb_arenas_{0u};
+	std::unique_ptr<std::atomic<std::uintptr_t>[]> arena_table_{new std::atomic<std::uintptr_t>[ARENA_TABLE_SIZE]()};
+
+	// the state below is protected by the mutex
+	std::mutex mutex_;
+	std::uintptr_t current_ = 0u;
+	std::size_t current_used_ = 0u;
+	std::unordered_map<std::size_t, std::vector<void*>> free_chunks_;
+	std::size_t free_bytes_ = 0u;
+
+	static uint32 table_slot(std::uintptr_t base)
+	{
+		return uint32((base / ARENA_SIZE) * 2654435761u) % ARENA_TABLE_SIZE;
+	}
+
+	bool owns(const void* p) const
+	{
+		if (nb_arenas_.load(std::memory_order_acquire) == 0u)
+			return false;
+		const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(p) & ~(ARENA_SIZE - 1u);
+		for (uint32 slot = table_slot(base);; slot = (slot + 1u) % ARENA_TABLE_SIZE)
+		{
+			const std::uintptr_t b = arena_table_[slot].load(std::memory_order_acquire);
+			if (b == base)
+				return true;
+			if (b == 0u)
+				return false;
+		}
+	}
+
+	void register_arena(std::uintptr_t base)
+	{
+		uint32 slot = table_slot(base);
+		while (arena_table_[slot].load(std::memory_order_relaxed) != 0u)
+			slot = (slot + 1u) % ARENA_TABLE_SIZE;
+		arena_table_[slot].store(base, std::memory_order_release);
+		nb_arenas_.fetch_add(1u, std::memory_order_release);
+	}
+
+	void* allocate(std::size_t size)
+	{
+		std::vector<void*>& free_chunks = free_chunks_[size];
+		if (!free_chunks.empty())
+		{
+			void* p = free_chunks.back();
+			free_chunks.pop_back();
+			free_bytes_ -= size;
+			return p;
+		}
+		if (current_ == 0u || current_used_ + size > ARENA_SIZE)
+		{
+			if (nb_arenas_.load(std::memory_order_relaxed) == MAX_NB_ARENAS)
+				return nullptr;
+			void* arena = map_arena(placement_.load(std::memory_order_relaxed));
+			if (arena == nullptr)
+				return nullptr;
+			if (current_ != 0u)
+				free_bytes_ += ARENA_SIZE - current_used_; // unused end of the previous arena
+			current_ = reinterpret_cast<std::uintptr_t>(arena);
+			current_used_ = 0u;
+			register_arena(current_);
+		}
+		void* p = reinterpret_cast<void*>(current_ + current_used_);
+		current_used_ += size;
+		return p;
+	}
+
+	void release(void* p, std::size_t size)
+	{
+		free_chunks_[size].push_back(p);
+		free_bytes_ += size;
+	}
+};
+
+// never destroyed: attributes of static meshes may release their chunks at exit
+ChunkArenas& chunk_arenas()
+{
+	static ChunkArenas* arenas = new ChunkArenas();
+	return *arenas;
+}
+
+std::size_t cache_line_size(std::size_t size)
+{
+	return (size + CACHE_LINE_SIZE - 1u) & ~(CACHE_LINE_SIZE - 1u);
+}
+
+} // namespace
+
+void set_chunk_allocation_policy(const ChunkAllocationPolicy& policy)
+{
+	ChunkArenas& arenas = chunk_arenas();
+	arenas.huge_page_arenas_.store(policy.huge_page_arenas, std::memory_order_relaxed);
+	arenas.placement_.store(policy.placement, std::memory_order_relaxed);
+	arenas.parallel_first_touch_.store(policy.parallel_first_touch, std::memory_order_relaxed);
+}
+
+ChunkAllocationPolicy chunk_allocation_policy()
+{
+	ChunkArenas& arenas = chunk_arenas();
+	ChunkAllocationPolicy policy;
+	policy.huge_page_arenas = arenas.huge_page_arenas_.load(std::memory_order_relaxed);
+	policy.placement = arenas.placement_.load(std::memory_order_relaxed);
+	policy.parallel_first_touch = arenas.parallel_first_touch_.load(std::memory_order_relaxed);
+	return policy;
+}
+
+void* allocate_chunk_memory(std::size_t size)
+{
+	size = cache_line_size(size);
+	ChunkArenas& arenas = chunk_arenas();
+	// chunks of large elements would waste too much of an arena
+	if (size <= ARENA_SIZE / 8u && arenas.huge_page_arenas_.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(arenas.mutex_);
+		void* p = arenas.allocate(size);
+		if (p != nullptr)
+			return p;
+	}
+	return ::operator new(size, std::align_val_t(CACHE_LINE_SIZE));
+}
+
+void release_chunk_memory(void* p, std::size_t size)
+{
+	size = cache_line_size(size);
+	ChunkArenas& arenas = chunk_arenas();
+	if (arenas.owns(p))
+	{
+		std::lock_guard<std::mutex> lock(arenas.mutex_);
+		arenas.release(p, size);
+		return;
+	}
+	::operator delete(p, std::align_val_t(CACHE_LINE_SIZE));
+}
+
+ChunkArenasReport chunk_arenas_report()
+{
+	ChunkArenas& arenas = chunk_arenas();
+	std::lock_guard<std::mutex> lock(arenas.mutex_);
+	ChunkArenasReport report;
+	report.nb_arenas = arenas.nb_arenas_.load(std::memory_order_relaxed);
+	report.arenas_bytes = std::size_t(report.nb_arenas) * ARENA_SIZE;
+	report.free_bytes = arenas.free_bytes_;
+	if (arenas.current_ != 0u)
+		report.free_bytes += ARENA_SIZE - arenas.current_used_;
+	return report;
+}
+
+} // namespace cgogn
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_CORE_TYPES_CONTAINER_CHUNK_ALLOCATOR_H_
+#define CGOGN_CORE_TYPES_CONTAINER_CHUNK_ALLOCATOR_H_
+
+#include <cgogn/core/cgogn_core_export.h>
+
+#include <cgogn/core/utils/numerics.h>
+
+#include <cstddef>
+
+namespace cgogn
+{
+
+/////////////////////////////
+// Chunk allocation policy //
+/////////////////////////////
+
+enum class ChunkPlacement : uint8
+{
+	LOCAL = 0,	// pages are placed on the node of the thread that first touches them
+	INTERLEAVE // pages of the arenas are spread round-robin on all the NUMA nodes
+};
+
+/**
+ * @brief how the memory of the attributes chunks (see ChunkArray) is obtained
+ * The policy only applies to the chunks allocated after it is set: chunks already allocated
+ * are released where they come from.
+ */
+struct ChunkAllocationPolicy
+{
+	// carve the chunks in 2 MiB aligned arenas advised to be backed by transparent huge pages
+	// (fewer TLB misses when streaming large attributes); arenas memory is recycled, never given back
+	bool huge_page_arenas = false;
+	// INTERLEAVE only applies to arenas memory (linux only)
+	ChunkPlacement placement = ChunkPlacement::LOCAL;
+	// value-initialize the chunks allocated together (growth by many indices, new attribute on a filled container)
+	// with the thread pool, so that with LOCAL placement the pages of the types whose value-initialization writes
+	// (scalars, indices) land on the nodes of the threads that will traverse them
+	bool parallel_first_touch = true;
+};
+
+CGOGN_CORE_EXPORT void set_chunk_allocation_policy(const ChunkAllocationPolicy& policy);
+CGOGN_CORE_EXPORT ChunkAllocationPolicy chunk_allocation_policy();
+
+// raw (not constructed) memory of size bytes, aligned on a cache line
+CGOGN_CORE_EXPORT void* allocate_chunk_memory(std::size_t size);
+// size must be the one given at allocation
+CGOGN_CORE_EXPORT void release_chunk_memory(void* p, std::size_t size);
+
+struct ChunkArenasReport
+{
+	uint32 nb_arenas = 0u;
+	std::size_t arenas_bytes = 0u;
+	std::size_t free_bytes = 0u; // released chunks waiting for reuse and unused end of the arenas
+};
+
+CGOGN_CORE_EXPORT ChunkArenasReport chunk_arenas_report();
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_CONTAINER_CHUNK_ALLOCATOR_H_
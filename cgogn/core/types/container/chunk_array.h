@@ -27,8 +27,10 @@
 #include <cgogn/core/cgogn_core_export.h>
 
 #include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/work_stealing.h>
 
 #include <cgogn/core/types/container/attribute_container.h>
+#include <cgogn/core/types/container/chunk_allocator.h>
 
 #include <memory>
 #include <string>
@@ -51,13 +53,87 @@ private:
 	std::vector<T*> chunks_;
 	uint32 capacity_;
 
+	// the first nb_external_chunks_ chunks are not owned by the attribute
+	// they point into an external memory block (e.g. a mapped file) kept alive by external_memory_
+	uint32 nb_external_chunks_;
+	std::shared_ptr<void> external_memory_;
+
+	// chunks memory comes from the current chunk allocation policy (see chunk_allocator.h)
+	static inline T* new_chunk()
+	{
+		T* chunk = static_cast<T*>(allocate_chunk_memory(CHUNK_SIZE * sizeof(T)));
+		std::uninitialized_value_construct_n(chunk, CHUNK_SIZE);
+		return chunk;
+	}
+
+	static inline void delete_chunk(T* chunk)
+	{
+		std::destroy_n(chunk, CHUNK_SIZE);
+		release_chunk_memory(chunk, CHUNK_SIZE * sizeof(T));
+	}
+
 	inline void manage_index(uint32 index) override
 	{
-		while (index >= capacity_)
+		if (index < capacity_)
+			return;
+		const uint32 first_chunk = uint32(chunks_.size());
+		const uint32 nb_chunks = index / CHUNK_SIZE + 1u;
+		chunks_.resize(nb_chunks);
+		// many chunks at once (e.g. new attribute on a filled container): each thread first touches the chunks it builds
+		if (nb_chunks - first_chunk >= 16u && chunk_allocation_policy().parallel_first_touch)
+			parallel_foreach_range(
+				first_chunk, nb_chunks,
+				[&](uint32 begin, uint32 end) {
+					for (uint32 c = begin; c < end; ++c)
+						chunks_[c] = new_chunk();
+				},
+				1u);
+		else
+			for (uint32 c = first_chunk; c < nb_chunks; ++c)
+				chunks_[c] = new_chunk();
+		capacity_ = nb_chunks * CHUNK_SIZE;
+	}
+
+	inline void compact(const std::vector<uint32>& old_new_indices, uint32 nb_elements) override
+	{
+		for (uint32 i = 0, end = uint32(old_new_indices.size()); i < end; ++i)
+		{
+			uint32 new_index = old_new_indices[i];
+			if (new_index != INVALID_INDEX && new_index != i)
+				(*this)[new_index] = std::move((*this)[i]);
+		}
+		uint32 nb_chunks = (nb_elements + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		while (uint32(chunks_.size()) > nb_chunks)
 		{
-			chunks_.push_back(new T[CHUNK_SIZE]());
-			capacity_ = uint32(chunks_.size()) * CHUNK_SIZE;
+			if (uint32(chunks_.size()) > nb_external_chunks_)
+				delete_chunk(chunks_.back());
+			else
+				--nb_external_chunks_;
+			chunks_.pop_back();
 		}
+		capacity_ = uint32(chunks_.size()) * CHUNK_SIZE;
+	}
+
+	inline void permute(const std::vector<uint32>& new_old_indices) override
+	{
+		const uint32 nb_elements = uint32(new_old_indices.size());
+		std::vector<T*> chunks((nb_elements + CHUNK_SIZE - 1u) / CHUNK_SIZE);
+		// ranges are made of whole chunks: each thread allocates (and first touches) the chunks it fills
+		parallel_foreach_range(
+			0u, nb_elements,
+			[&](uint32 begin, uint32 end) {
+				for (uint32 c = begin / CHUNK_SIZE; c * CHUNK_SIZE < end; ++c)
+					chunks[c] = new_chunk();
+				for (uint32 i = begin; i < end; ++i)
+					chunks[i / CHUNK_SIZE][i % CHUNK_SIZE] = std::move((*this)[new_old_indices[i]]);
+			},
+			CHUNK_SIZE);
+		for (uint32 i = nb_external_chunks_; i < uint32(chunks_.size()); ++i)
+			delete_chunk(chunks_[i]);
+		chunks_.swap(chunks);
+		nb_external_chunks_ = 0u;
+		external_memory_.reset();
+		capacity_ = uint32(chunks_.size()) * CHUNK_SIZE;
 	}
 
 public:
@@ -65,12 +141,13 @@ public:
 	{
 		chunks_.reserve(512u);
 		capacity_ = 0u;
+		nb_external_chunks_ = 0u;
 	}
 
 	~ChunkArray() override
 	{
-		for (auto chunk : chunks_)
-			delete[] chunk;
+		for (uint32 i = nb_external_chunks_; i < uint32(chunks_.size()); ++i)
+			delete_chunk(chunks_[i]);
 	}
 
 	inline T& operator[](uint32 index)
@@ -89,19 +166,29 @@ public:
 	{
 		for (auto chunk : chunks_)
 			std::fill(chunk, chunk + CHUNK_SIZE, value);
+		mark_all_modified();
 	}
 
 	inline void swap(ChunkArray<T>* ca)
 	{
 		if (ca->container_ == this->container_)
+		{
 			chunks_.swap(ca->chunks_);
+			std::swap(nb_external_chunks_, ca->nb_external_chunks_);
+			external_memory_.swap(ca->external_memory_);
+			mark_all_modified();
+			ca->mark_all_modified();
+		}
 	}
 
 	inline void copy(ChunkArray<T>* ca)
 	{
 		if (ca->container_ == this->container_)
+		{
 			for (uint32 i = 0; i < uint32(chunks_.size()); ++i)
 				std::copy(ca->chunks_[i], ca->chunks_[i] + CHUNK_SIZE, chunks_[i]);
+			mark_all_modified();
+		}
 	}
 
 	inline uint32 nb_chunks() const
@@ -109,6 +196,36 @@ public:
 		return uint32(chunks_.size());
 	}
 
+	inline uint32 capacity() const override
+	{
+		return capacity_;
+	}
+
+	// external chunks are not counted
+	inline std::size_t memory_size() const override
+	{
+		std::size_t size = chunks_.capacity() * sizeof(T*) + modification_stamps_memory_size();
+		for (uint32 i = nb_external_chunks_; i < uint32(chunks_.size()); ++i)
+			size += CHUNK_SIZE * sizeof(T) + internal::heap_size(chunks_[i], chunks_[i] + CHUNK_SIZE);
+		return size;
+	}
+
+	/**
+	 * @brief replace the chunks of the attribute by the given external chunks of CHUNK_SIZE elements
+	 * The values are neither copied nor owned (T must not own any resource): memory is kept alive
+	 * as long as the attribute uses the chunks. Chunks added later (by new indices) are allocated and owned as usual.
+	 */
+	inline void adopt_chunks(const std::vector<T*>& chunks, std::shared_ptr<void> memory)
+	{
+		for (uint32 i = nb_external_chunks_; i < uint32(chunks_.size()); ++i)
+			delete_chunk(chunks_[i]);
+		chunks_ = chunks;
+		nb_external_chunks_ = uint32(chunks_.size());
+		external_memory_ = std::move(memory);
+		capacity_ = uint32(chunks_.size()) * CHUNK_SIZE;
+		mark_all_modified();
+	}
+
 	inline std::vector<const void*> chunk_pointers() const
 	{
 		std::vector<const void*> pointers;
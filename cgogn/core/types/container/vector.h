@@ -27,6 +27,7 @@
 #include <cgogn/core/cgogn_core_export.h>
 
 #include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/work_stealing.h>
 
 #include <cgogn/core/types/container/attribute_container.h>
 
@@ -53,6 +54,28 @@ private:
 			data_.push_back(T());
 	}
 
+	inline void compact(const std::vector<uint32>& old_new_indices, uint32 nb_elements) override
+	{
+		for (uint32 i = 0, end = uint32(old_new_indices.size()); i < end; ++i)
+		{
+			uint32 new_index = old_new_indices[i];
+			if (new_index != INVALID_INDEX && new_index != i)
+				data_[new_index] = std::move(data_[i]);
+		}
+		data_.resize(nb_elements);
+		data_.shrink_to_fit();
+	}
+
+	inline void permute(const std::vector<uint32>& new_old_indices) override
+	{
+		std::vector<T> data(new_old_indices.size());
+		parallel_foreach_range(0u, uint32(new_old_indices.size()), [&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+				data[i] = std::move(data_[new_old_indices[i]]);
+		});
+		data_.swap(data);
+	}
+
 public:
 	Vector(AttributeContainerGen* container, const std::string& name) : AttributeGenT(container, name)
 	{
@@ -78,18 +101,26 @@ public:
 	inline void fill(const T& value)
 	{
 		std::fill(data_.begin(), data_.end(), value);
+		mark_all_modified();
 	}
 
 	inline void swap(Vector<T>* ca)
 	{
 		if (ca->container_ == this->container_)
+		{
 			data_.swap(ca->data_);
+			mark_all_modified();
+			ca->mark_all_modified();
+		}
 	}
 
 	inline void copy(Vector<T>* ca)
 	{
 		if (ca->container_ == this->container_)
+		{
 			data_ = ca->data_;
+			mark_all_modified();
+		}
 	}
 
 	inline const void* data_pointer() const
@@ -97,6 +128,16 @@ public:
 		return &data_[0];
 	}
 
+	inline uint32 capacity() const override
+	{
+		return uint32(data_.capacity());
+	}
+
+	inline std::size_t memory_size() const override
+	{
+		return internal::heap_size(data_) + modification_stamps_memory_size();
+	}
+
 	class const_iterator
 	{
 		const Vector<T>* ca_;
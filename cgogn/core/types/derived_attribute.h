@@ -0,0 +1,351 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_CORE_TYPES_DERIVED_ATTRIBUTE_H_
+#define CGOGN_CORE_TYPES_DERIVED_ATTRIBUTE_H_
+
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/traversals/edge.h>
+#include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/functions/traversals/volume.h>
+#include <cgogn/core/types/cell_marker.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/work_stealing.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cgogn
+{
+
+class DerivedAttributeGen
+{
+public:
+	virtual ~DerivedAttributeGen()
+	{
+	}
+
+	// type_hash of the concrete derived attribute type
+	virtual uint64 type_hash() const = 0;
+
+	// the next update will recompute the values of all the cells (e.g. after a topological modification)
+	virtual void invalidate() = 0;
+
+	virtual void update_values() = 0;
+};
+
+// derived attributes of a mesh, by name
+using DerivedAttributes = std::unordered_map<std::string, std::shared_ptr<DerivedAttributeGen>>;
+
+/**
+ * @brief attribute of the cells of type CELL whose values are computed from input attributes by a kernel
+ * The values are stored in a regular attribute of the mesh (of the same name) and are computed lazily, by update:
+ * - nothing is done if no input was modified since the last update
+ * - if some chunks of the inputs were marked as modified (see the modification tracking of attributes), only the
+ *   cells having an incident input cell in these chunks are recomputed (the cells depending on each chunk of the
+ *   inputs are listed at the first partial update and kept until the next invalidation)
+ * - otherwise (e.g. an untracked input was committed) all the cells are recomputed
+ * The modified values are marked and committed, so that a derived attribute can itself be the input of other
+ * derived attributes (e.g. vertex normals computed from face normals) or be incrementally uploaded for rendering.
+ * The kernel is called concurrently and must only read the mesh and the inputs.
+ * After a topological modification of the mesh, invalidate must be called (see invalidate_derived_attributes).
+ * Derived attributes are registered in the mesh (see add_derived_attribute) to be shared by all their users.
+ */
+template <typename MESH, typename CELL, typename T>
+class DerivedAttribute : public DerivedAttributeGen
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+
+public:
+	using Attribute = typename mesh_traits<MESH>::template Attribute<T>;
+	using AttributeGen = typename mesh_traits<MESH>::AttributeGen;
+
+private:
+	struct Input
+	{
+		std::shared_ptr<AttributeGen> attribute;
+		// derived attribute of which attribute holds the values (nullptr if none), updated first
+		std::shared_ptr<DerivedAttributeGen> source;
+		// version of the input the values were computed from
+		uint64 version;
+		// fills, for each chunk of the input, the cells having an incident input cell in this chunk
+		std::function<void(std::vector<std::vector<CELL>>&)> build_dependents;
+		// built at the first partial update (and rebuilt after each invalidation)
+		std::vector<std::vector<CELL>> dependents;
+		std::vector<uint32> modified_chunks;
+	};
+
+	MESH& m_;
+	std::shared_ptr<Attribute> attribute_;
+	std::function<T(CELL)> compute_;
+	std::vector<Input> inputs_;
+	bool valid_;
+
+	template <typename INCIDENT, typename FUNC>
+	void foreach_incident_in_mesh(CELL c, const FUNC& f) const
+	{
+		if constexpr (std::is_same_v<INCIDENT, CELL>)
+			f(c);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Vertex>)
+			foreach_incident_vertex(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Edge>)
+			foreach_incident_edge(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Face>)
+			foreach_incident_face(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Volume>)
+			foreach_incident_volume(m_, c, f);
+		else
+			static_assert(!std::is_same_v<INCIDENT, INCIDENT>, "INCIDENT cell type not supported");
+	}
+
+public:
+	DerivedAttribute(MESH& m, const std::shared_ptr<Attribute>& attribute, const std::function<T(CELL)>& compute)
+		: m_(m), attribute_(attribute), compute_(compute), valid_(false)
+	{
+		attribute_->enable_modification_tracking();
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(DerivedAttribute);
+
+	uint64 type_hash() const override
+	{
+		return cgogn::type_hash<DerivedAttribute<MESH, CELL, T>>();
+	}
+
+	void invalidate() override
+	{
+		valid_ = false;
+		for (Input& input : inputs_)
+			input.dependents.clear();
+	}
+
+	/**
+	 * @brief declare an attribute of the cells of type INPUT_CELL read by the kernel
+	 * The value of a cell is supposed to only depend on the values of its incident cells of type INPUT_CELL
+	 * (or on its own value if INPUT_CELL is CELL).
+	 */
+	template <typename INPUT_CELL, typename ATTRIBUTE>
+	void add_input(const std::shared_ptr<ATTRIBUTE>& attribute)
+	{
+		static_assert(is_in_tuple<INPUT_CELL, typename mesh_traits<MESH>::Cells>::value,
+					  "INPUT_CELL not supported in this MESH");
+		static_assert(std::is_base_of_v<AttributeGen, ATTRIBUTE>, "ATTRIBUTE is not an attribute");
+		static const uint32 chunk_size = AttributeGen::MODIFICATION_CHUNK_SIZE;
+		inputs_.push_back({attribute, nullptr, attribute->version(),
+						   [this, attribute](std::vector<std::vector<CELL>>& dependents) {
+							   dependents.clear();
+							   dependents.resize((attribute->maximum_index() + chunk_size - 1u) / chunk_size);
+							   foreach_cell(m_, [&](CELL c) -> bool {
+								   foreach_incident_in_mesh<INPUT_CELL>(c, [&](INPUT_CELL ic) -> bool {
+									   std::vector<CELL>& chunk_dependents = dependents[index_of(m_, ic) / chunk_size];
+									   if (chunk_dependents.empty() ||
+										   index_of(m_, chunk_dependents.back()) != index_of(m_, c))
+										   chunk_dependents.push_back(c);
+									   return true;
+								   });
+								   return true;
+							   });
+						   },
+						   {},
+						   {}});
+		valid_ = false;
+	}
+
+	// an input that is itself derived is updated before this one
+	template <typename INPUT_CELL, typename U>
+	void add_input(const std::shared_ptr<DerivedAttribute<MESH, INPUT_CELL, U>>& derived_attribute)
+	{
+		add_input<INPUT_CELL>(derived_attribute->attribute());
+		inputs_.back().source = derived_attribute;
+	}
+
+	// the values, possibly not up to date (see update)
+	inline const std::shared_ptr<Attribute>& attribute() const
+	{
+		return attribute_;
+	}
+
+	/**
+	 * @brief recompute the values of the cells whose inputs were modified since the last update
+	 * The modifications of the inputs are seen as soon as they are marked, or when they are committed for
+	 * untracked inputs.
+	 */
+	const std::shared_ptr<Attribute>& update()
+	{
+		update_values();
+		return attribute_;
+	}
+
+	void update_values() override
+	{
+		static const uint32 chunk_size = AttributeGen::MODIFICATION_CHUNK_SIZE;
+
+		bool all = !valid_;
+		bool modified = all;
+		for (Input& input : inputs_)
+		{
+			if (input.source)
+				input.source->update_values();
+			const uint32 maximum_index = input.attribute->maximum_index();
+			input.modified_chunks.clear();
+			input.attribute->foreach_modified_range(input.version, [&](uint32 begin, uint32 end) {
+				modified = true;
+				if (begin == 0u && end == maximum_index)
+					all = true;
+				for (uint32 c = begin / chunk_size; c * chunk_size < end; ++c)
+					input.modified_chunks.push_back(c);
+			});
+			input.version = input.attribute->version();
+		}
+		if (!modified)
+			return;
+
+		if (all)
+		{
+			parallel_foreach_cell(m_, [&](CELL c) -> bool {
+				value<T>(m_, attribute_, c) = compute_(c);
+				return true;
+			});
+		}
+		else
+		{
+			// the cells depending on the modified chunks, each cell once
+			std::vector<CELL> cells;
+			CellMarkerStore<MESH, CELL> marker(m_);
+			for (Input& input : inputs_)
+			{
+				if (input.modified_chunks.empty())
+					continue;
+				if (input.dependents.empty())
+					input.build_dependents(input.dependents);
+				for (uint32 chunk : input.modified_chunks)
+				{
+					// chunks added since the dependents were built hold new cells (see invalidate)
+					if (chunk >= uint32(input.dependents.size()))
+						continue;
+					for (CELL c : input.dependents[chunk])
+					{
+						if (!marker.is_marked(c))
+						{
+							marker.mark(c);
+							cells.push_back(c);
+						}
+					}
+				}
+			}
+			parallel_foreach_range(0u, uint32(cells.size()), [&](uint32 begin, uint32 end) {
+				for (uint32 i = begin; i < end; ++i)
+				{
+					value<T>(m_, attribute_, cells[i]) = compute_(cells[i]);
+					attribute_->mark_modified(index_of(m_, cells[i]));
+				}
+			});
+		}
+		if (all)
+			attribute_->mark_all_modified();
+		attribute_->commit_modifications();
+		valid_ = true;
+	}
+};
+
+/*****************************************************************************/
+
+// template <typename T, typename CELL, typename MESH>
+// std::shared_ptr<DerivedAttribute<MESH, CELL, T>> get_derived_attribute(MESH& m, const std::string& name);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+template <typename T, typename CELL, typename MESH>
+auto get_derived_attribute(MESH& m, const std::string& name)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>, std::shared_ptr<DerivedAttribute<MESH, CELL, T>>>
+{
+	CMapBase& mb = static_cast<CMapBase&>(m);
+	DerivedAttributes& derived_attributes = mb.get_attribute<DerivedAttributes>("derived_attributes");
+	auto it = derived_attributes.find(name);
+	if (it == derived_attributes.end() || it->second->type_hash() != type_hash<DerivedAttribute<MESH, CELL, T>>())
+		return nullptr;
+	return std::static_pointer_cast<DerivedAttribute<MESH, CELL, T>>(it->second);
+}
+
+/*****************************************************************************/
+
+// template <typename T, typename CELL, typename MESH, typename FUNC>
+// std::shared_ptr<DerivedAttribute<MESH, CELL, T>> add_derived_attribute(MESH& m, const std::string& name,
+// const FUNC& compute);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+template <typename T, typename CELL, typename MESH, typename FUNC>
+auto add_derived_attribute(MESH& m, const std::string& name, const FUNC& compute)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>, std::shared_ptr<DerivedAttribute<MESH, CELL, T>>>
+{
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function parameter type");
+	static_assert(std::is_convertible_v<func_return_type<FUNC>, T>, "Wrong function return type");
+	CMapBase& mb = static_cast<CMapBase&>(m);
+	DerivedAttributes& derived_attributes = mb.get_attribute<DerivedAttributes>("derived_attributes");
+	if (derived_attributes.count(name) > 0u)
+		return nullptr;
+	auto attribute = add_attribute<T, CELL>(m, name);
+	if (!attribute)
+		return nullptr;
+	auto derived_attribute = std::make_shared<DerivedAttribute<MESH, CELL, T>>(m, attribute, compute);
+	derived_attributes.emplace(name, derived_attribute);
+	return derived_attribute;
+}
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// void invalidate_derived_attributes(const MESH& m);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+inline void invalidate_derived_attributes(const CMapBase& m)
+{
+	// derived values are a cache of the mesh: invalidating them does not modify the mesh
+	CMapBase& mb = const_cast<CMapBase&>(m);
+	for (auto& [name, derived_attribute] : mb.get_attribute<DerivedAttributes>("derived_attributes"))
+		derived_attribute->invalidate();
+}
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_DERIVED_ATTRIBUTE_H_
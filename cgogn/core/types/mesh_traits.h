@@ -29,6 +29,7 @@
 #include <cgogn/core/types/cmap/cmap3.h>
 #include <cgogn/core/types/cmap/cph3.h>
 #include <cgogn/core/types/cmap/graph.h>
+#include <cgogn/core/types/cmap/trimap2.h>
 
 namespace cgogn
 {
@@ -93,6 +94,12 @@ struct mesh_traits<CMap2>
 	using MarkAttribute = CMapBase::MarkAttribute;
 };
 
+template <>
+struct mesh_traits<TriMap2> : public mesh_traits<CMap2>
+{
+	static constexpr const char* name = "TriMap2";
+};
+
 template <>
 struct mesh_traits<CMap3>
 {
@@ -0,0 +1,239 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_CORE_TYPES_MESH_VIEWS_CELL_COLORING_H_
+#define CGOGN_CORE_TYPES_MESH_VIEWS_CELL_COLORING_H_
+
+#include <cgogn/core/cgogn_core_export.h>
+
+#include <cgogn/core/functions/traversals/edge.h>
+#include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/functions/traversals/volume.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/types/mesh_views/cell_cache.h>
+
+#include <vector>
+
+namespace cgogn
+{
+
+/**
+ * @brief partition of the cells of type CELL of a mesh into color classes, such that the cells of a class can be
+ * processed concurrently by kernels that also write into the neighborhood of the cell (see
+ * parallel_foreach_cell_colored), without atomics nor double buffering.
+ * Two cells conflict if they are incident to a same cell of type THROUGH (distance 1 coloring) or, for a
+ * distance 2 coloring, if they also both conflict with a same third cell. For example:
+ * - Vertex through Edge, distance 1: a vertex can be updated in place from its adjacent vertices (Gauss-Seidel)
+ * - Vertex through Edge, distance 2: a vertex can also write into its adjacent vertices
+ * - Edge through Face: an edge can write into its incident faces
+ * - Face through Vertex: a face can write into its incident vertices and edges
+ * Cells are colored greedily in the traversal order of the mesh (each cell takes the smallest color not used by
+ * a conflicting cell), so the coloring is deterministic. The cells of a class are kept in traversal order.
+ * The coloring is only valid as long as the topology of the mesh is not modified.
+ */
+template <typename MESH, typename CELL>
+class CellColoring
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+
+	const MESH& m_;
+	// the cells of color k are cells_[offsets_[k]] .. cells_[offsets_[k + 1] - 1]
+	std::vector<CELL> cells_;
+	std::vector<uint32> offsets_;
+
+	template <typename INCIDENT, typename C, typename FUNC>
+	void foreach_incident_in_mesh(C c, const FUNC& f) const
+	{
+		if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Vertex>)
+			foreach_incident_vertex(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Edge>)
+			foreach_incident_edge(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Face>)
+			foreach_incident_face(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Volume>)
+			foreach_incident_volume(m_, c, f);
+		else
+			static_assert(!std::is_same_v<INCIDENT, INCIDENT>, "INCIDENT cell type not supported");
+	}
+
+public:
+	CellColoring(const MESH& m) : m_(m)
+	{
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CellColoring);
+
+	operator MESH&()
+	{
+		return const_cast<MESH&>(m_);
+	}
+	operator const MESH&() const
+	{
+		return m_;
+	}
+
+	/**
+	 * @brief color all the cells of type CELL (see the class description)
+	 * CELL gets indexed if it is not already.
+	 */
+	template <typename THROUGH>
+	void build(uint32 distance = 1u)
+	{
+		build<THROUGH>(distance, [](CELL) { return true; });
+	}
+
+	/**
+	 * @brief color the cells of type CELL for which filter returns true
+	 * Conflicts through the cells that are not colored are still taken into account for a distance 2 coloring.
+	 */
+	template <typename THROUGH, typename FUNC>
+	void build(uint32 distance, const FUNC& filter)
+	{
+		static_assert(is_in_tuple<THROUGH, typename mesh_traits<MESH>::Cells>::value,
+					  "THROUGH not supported in this MESH");
+		static_assert(!std::is_same_v<THROUGH, CELL>, "THROUGH must be different from CELL");
+		static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+		cgogn_message_assert(distance == 1u || distance == 2u, "Only distance 1 & 2 colorings are supported");
+
+		if (!is_indexed<CELL>(m_))
+			index_cells<CELL>(const_cast<MESH&>(m_));
+
+		CellCache<MESH> cache(m_);
+		cache.template build<CELL>();
+
+		// conflicting cells of each cell (indexed by cell index) in compressed rows
+		std::vector<uint32> conflict_offsets(maximum_index<CELL>(m_) + 1u, 0u);
+		auto foreach_conflicting = [&](CELL c, const auto& f) {
+			foreach_incident_in_mesh<THROUGH>(c, [&](THROUGH t) -> bool {
+				foreach_incident_in_mesh<CELL>(t, [&](CELL c2) -> bool {
+					if (index_of(m_, c2) != index_of(m_, c))
+						f(index_of(m_, c2));
+					return true;
+				});
+				return true;
+			});
+		};
+		parallel_foreach_cell(cache, [&](CELL c) -> bool {
+			uint32& nb = conflict_offsets[index_of(m_, c) + 1u];
+			foreach_conflicting(c, [&](uint32) { ++nb; });
+			return true;
+		});
+		for (uint32 i = 1u, end = uint32(conflict_offsets.size()); i < end; ++i)
+			conflict_offsets[i] += conflict_offsets[i - 1u];
+		std::vector<uint32> conflicts(conflict_offsets.back());
+		parallel_foreach_cell(cache, [&](CELL c) -> bool {
+			uint32 k = conflict_offsets[index_of(m_, c)];
+			foreach_conflicting(c, [&](uint32 index) { conflicts[k++] = index; });
+			return true;
+		});
+
+		// greedy coloring: forbidden[k] == i if color k is used by a cell conflicting with the i-th colored cell
+		std::vector<uint32> color(maximum_index<CELL>(m_), INVALID_INDEX);
+		std::vector<uint32> forbidden;
+		std::vector<uint32> nb_cells_per_color;
+		std::vector<CELL> colored_cells;
+		for (CELL c : cache.template cell_vector<CELL>())
+		{
+			if (!filter(c))
+				continue;
+			const uint32 i = uint32(colored_cells.size());
+			const uint32 index = index_of(m_, c);
+			for (uint32 k = conflict_offsets[index]; k < conflict_offsets[index + 1u]; ++k)
+			{
+				const uint32 n = conflicts[k];
+				if (color[n] != INVALID_INDEX)
+					forbidden[color[n]] = i;
+				if (distance == 2u)
+				{
+					for (uint32 k2 = conflict_offsets[n]; k2 < conflict_offsets[n + 1u]; ++k2)
+					{
+						const uint32 n2 = conflicts[k2];
+						if (color[n2] != INVALID_INDEX)
+							forbidden[color[n2]] = i;
+					}
+				}
+			}
+			uint32 col = 0u;
+			while (col < uint32(forbidden.size()) && forbidden[col] == i)
+				++col;
+			if (col == uint32(forbidden.size()))
+			{
+				forbidden.push_back(INVALID_INDEX);
+				nb_cells_per_color.push_back(0u);
+			}
+			color[index] = col;
+			++nb_cells_per_color[col];
+			colored_cells.push_back(c);
+		}
+
+		// group the cells by color (keeping the traversal order in each class)
+		const uint32 nb_colors = uint32(nb_cells_per_color.size());
+		offsets_.assign(nb_colors + 1u, 0u);
+		for (uint32 k = 0u; k < nb_colors; ++k)
+			offsets_[k + 1u] = offsets_[k] + nb_cells_per_color[k];
+		std::vector<uint32> next(offsets_.begin(), offsets_.end() - 1);
+		cells_.resize(colored_cells.size());
+		for (CELL c : colored_cells)
+			cells_[next[color[index_of(m_, c)]]++] = c;
+	}
+
+	inline uint32 nb_colors() const
+	{
+		return offsets_.empty() ? 0u : uint32(offsets_.size()) - 1u;
+	}
+
+	// number of colored cells
+	inline uint32 size() const
+	{
+		return uint32(cells_.size());
+	}
+
+	// the cells of color k are cells()[color_begin(k)] .. cells()[color_end(k) - 1]
+	inline const std::vector<CELL>& cells() const
+	{
+		return cells_;
+	}
+
+	inline uint32 color_begin(uint32 color) const
+	{
+		return offsets_[color];
+	}
+
+	inline uint32 color_end(uint32 color) const
+	{
+		return offsets_[color + 1u];
+	}
+};
+
+template <typename MESH, typename CELL>
+struct mesh_traits<CellColoring<MESH, CELL>> : public mesh_traits<MESH>
+{
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_MESH_VIEWS_CELL_COLORING_H_
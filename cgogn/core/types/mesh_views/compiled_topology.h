@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_CORE_TYPES_MESH_VIEWS_COMPILED_TOPOLOGY_H_
+#define CGOGN_CORE_TYPES_MESH_VIEWS_COMPILED_TOPOLOGY_H_
+
+#include <cgogn/core/cgogn_core_export.h>
+
+#include <cgogn/core/functions/traversals/edge.h>
+#include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/functions/traversals/volume.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/types/mesh_views/cell_cache.h>
+#include <cgogn/core/utils/tuples.h>
+
+#include <array>
+
+namespace cgogn
+{
+
+/**
+ * @brief immutable incidence tables of a mesh in compressed sparse row format
+ * Once built, the cells incident to a cell (or the vertices adjacent to a vertex) are read from contiguous
+ * arrays indexed by the cell index instead of being found by walking the darts of the mesh.
+ * The view is only valid as long as the topology of the mesh is not modified.
+ * Traversals on a table or cell type that has not been built fall back on the mesh.
+ */
+template <typename MESH>
+class CompiledTopology
+{
+public:
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+
+	// the cells incident to the cell of index i are darts[offsets[i]] .. darts[offsets[i + 1] - 1]
+	// indices holds their indices (empty if the incident cell type is not indexed)
+	struct IncidenceTable
+	{
+		std::vector<uint32> offsets;
+		std::vector<Dart> darts;
+		std::vector<uint32> indices;
+	};
+
+private:
+	const MESH& m_;
+	CellCache<MESH> cells_;
+	std::array<bool, NB_ORBITS> cells_built_;
+	// tables_[o1][o2] holds cells of orbit o2 incident to cells of orbit o1
+	// (tables_[o][o] holds vertices adjacent through an edge for vertices)
+	std::array<std::array<IncidenceTable, NB_ORBITS>, NB_ORBITS> tables_;
+
+	template <typename INCIDENT, typename CELL, typename FUNC>
+	void foreach_incident_in_mesh(CELL c, const FUNC& f) const
+	{
+		if constexpr (std::is_same_v<INCIDENT, Vertex> && std::is_same_v<CELL, Vertex>)
+			foreach_adjacent_vertex_through_edge(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, Vertex>)
+			foreach_incident_vertex(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Edge>)
+			foreach_incident_edge(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Face>)
+			foreach_incident_face(m_, c, f);
+		else if constexpr (std::is_same_v<INCIDENT, typename mesh_traits<MESH>::Volume>)
+			foreach_incident_volume(m_, c, f);
+		else
+			static_assert(!std::is_same_v<INCIDENT, INCIDENT>, "INCIDENT cell type not supported");
+	}
+
+public:
+	CompiledTopology(const MESH& m) : m_(m), cells_(m)
+	{
+		cells_built_.fill(false);
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CompiledTopology);
+
+	operator MESH&()
+	{
+		return const_cast<MESH&>(m_);
+	}
+	operator const MESH&() const
+	{
+		return m_;
+	}
+
+	/**
+	 * @brief store the list of cells of type CELL (used by foreach_cell & parallel_foreach_cell)
+	 */
+	template <typename CELL>
+	void build()
+	{
+		static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+		cells_.template build<CELL>();
+		cells_built_[CELL::ORBIT] = true;
+	}
+
+	/**
+	 * @brief build the table of the cells of type INCIDENT incident to the cells of type CELL
+	 * If INCIDENT and CELL are both the Vertex type, the table holds the vertices adjacent through an edge.
+	 * CELL gets indexed if it is not already.
+	 */
+	template <typename CELL, typename INCIDENT>
+	void build()
+	{
+		static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+		static_assert(is_in_tuple<INCIDENT, typename mesh_traits<MESH>::Cells>::value,
+					  "INCIDENT not supported in this MESH");
+
+		if (!is_indexed<CELL>(m_))
+			index_cells<CELL>(const_cast<MESH&>(m_));
+		if (!cells_built_[CELL::ORBIT])
+			build<CELL>();
+
+		IncidenceTable& table = tables_[CELL::ORBIT][INCIDENT::ORBIT];
+		const bool incident_indexed = is_indexed<INCIDENT>(m_);
+
+		// first pass: count the incident cells of each cell
+		std::vector<uint32>& offsets = table.offsets;
+		offsets.assign(maximum_index<CELL>(m_) + 1u, 0u);
+		for (CELL c : cells_.template cell_vector<CELL>())
+		{
+			uint32& nb = offsets[index_of(m_, c) + 1u];
+			foreach_incident_in_mesh<INCIDENT>(c, [&](INCIDENT) -> bool {
+				++nb;
+				return true;
+			});
+		}
+		for (uint32 i = 1u, end = uint32(offsets.size()); i < end; ++i)
+			offsets[i] += offsets[i - 1u];
+
+		// second pass: fill the incident cells
+		table.darts.resize(offsets.back());
+		table.indices.resize(incident_indexed ? offsets.back() : 0u);
+		parallel_foreach_cell(cells_, [&](CELL c) -> bool {
+			uint32 k = offsets[index_of(m_, c)];
+			foreach_incident_in_mesh<INCIDENT>(c, [&](INCIDENT ic) -> bool {
+				table.darts[k] = ic.dart;
+				if (incident_indexed)
+					table.indices[k] = index_of(m_, ic);
+				++k;
+				return true;
+			});
+			return true;
+		});
+	}
+
+	template <typename CELL>
+	bool is_built() const
+	{
+		return cells_built_[CELL::ORBIT];
+	}
+
+	template <typename CELL, typename INCIDENT>
+	bool is_built() const
+	{
+		return !tables_[CELL::ORBIT][INCIDENT::ORBIT].offsets.empty();
+	}
+
+	const CellCache<MESH>& cell_cache() const
+	{
+		return cells_;
+	}
+
+	template <typename CELL, typename INCIDENT>
+	const IncidenceTable& table() const
+	{
+		cgogn_message_assert((is_built<CELL, INCIDENT>()), "Incidence table has not been built");
+		return tables_[CELL::ORBIT][INCIDENT::ORBIT];
+	}
+
+	/**
+	 * @brief apply f on the cells of the built table (CELL, INCIDENT) incident to c
+	 */
+	template <typename INCIDENT, typename CELL, typename FUNC>
+	void foreach_incident(CELL c, const FUNC& f) const
+	{
+		const IncidenceTable& t = tables_[CELL::ORBIT][INCIDENT::ORBIT];
+		const uint32 i = index_of(m_, c);
+		for (uint32 k = t.offsets[i], end = t.offsets[i + 1u]; k < end; ++k)
+			if (!f(INCIDENT(t.darts[k])))
+				break;
+	}
+
+	template <typename INCIDENT, typename CELL, typename FUNC>
+	void foreach_incident_or_fallback(CELL c, const FUNC& f) const
+	{
+		if (is_built<CELL, INCIDENT>())
+			foreach_incident<INCIDENT>(c, f);
+		else
+			foreach_incident_in_mesh<INCIDENT>(c, f);
+	}
+};
+
+template <typename MESH>
+struct mesh_traits<CompiledTopology<MESH>> : public mesh_traits<MESH>
+{
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_MESH_VIEWS_COMPILED_TOPOLOGY_H_
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/utils/numerics.h>
 
+#include <atomic>
 #include <vector>
 
 namespace cgogn
@@ -41,14 +42,19 @@ class Buffers
 protected:
 	std::vector<std::vector<T>*> buffers_;
 
+	// memory of the pooled buffers and number of buffers in use, readable from other threads (see memory_size)
+	std::atomic<std::size_t> pooled_bytes_;
+	std::atomic<uint32> nb_used_buffers_;
+
 public:
-	Buffers()
+	Buffers() : pooled_bytes_(0u), nb_used_buffers_(0u)
 	{
 		for (uint32 i = 0u; i < 8u; ++i)
 		{
 			std::vector<T>* v = new std::vector<T>;
 			v->reserve(DEFAULT_SIZE);
 			buffers_.push_back(v);
+			pooled_bytes_.fetch_add(v->capacity() * sizeof(T), std::memory_order_relaxed);
 		}
 	}
 
@@ -60,6 +66,7 @@ public:
 
 	inline std::vector<T>* buffer()
 	{
+		nb_used_buffers_.fetch_add(1u, std::memory_order_relaxed);
 		if (buffers_.empty())
 		{
 			std::vector<T>* v = new std::vector<T>;
@@ -69,6 +76,7 @@ public:
 
 		std::vector<T>* v = buffers_.back();
 		buffers_.pop_back();
+		pooled_bytes_.fetch_sub(v->capacity() * sizeof(T), std::memory_order_relaxed);
 		return v;
 	}
 
@@ -82,12 +90,25 @@ public:
 
 		b->clear();
 		buffers_.push_back(b);
+		pooled_bytes_.fetch_add(b->capacity() * sizeof(T), std::memory_order_relaxed);
+		nb_used_buffers_.fetch_sub(1u, std::memory_order_relaxed);
 	}
 
 	uint32 nb_buffers()
 	{
 		return uint32(buffers_.size());
 	}
+
+	// bytes of the buffers kept in the pool (buffers in use are not counted: their size is only known on release)
+	inline std::size_t memory_size() const
+	{
+		return pooled_bytes_.load(std::memory_order_relaxed);
+	}
+
+	inline uint32 nb_used_buffers() const
+	{
+		return nb_used_buffers_.load(std::memory_order_relaxed);
+	}
 };
 
 } // namespace cgogn
@@ -32,6 +32,10 @@
 
 #include <cgogn/core/utils/assert.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace cgogn
 {
 
@@ -145,6 +149,37 @@ inline Scalar clamp(const Scalar x, const Scalar min, const Scalar max)
 	return std::min(max, std::max(min, x));
 }
 
+/**
+ * @brief index of the lowest set bit of x (x must not be 0)
+ */
+inline uint32 count_trailing_zeros(uint64 x)
+{
+	cgogn_message_assert(x != 0u, "count_trailing_zeros of 0 is undefined");
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return uint32(index);
+#else
+	return uint32(__builtin_ctzll(x));
+#endif
+}
+
+/**
+ * @brief number of set bits of x
+ */
+inline uint32 count_ones(uint64 x)
+{
+#if defined(__POPCNT__)
+	return uint32(__builtin_popcountll(x));
+#else
+	// without the popcnt instruction the builtin is a library call
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return uint32((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
 template <typename T, std::size_t bytes, typename enable = void>
 struct fixed_precision
 {
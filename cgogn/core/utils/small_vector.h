@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_CORE_UTILS_SMALL_VECTOR_H_
+#define CGOGN_CORE_UTILS_SMALL_VECTOR_H_
+
+#include <cgogn/core/utils/assert.h>
+#include <cgogn/core/utils/numerics.h>
+
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cgogn
+{
+
+/**
+ * @brief vector of trivially destructible elements with an inline storage for the N first ones
+ * The elements are moved to the heap (with a doubling growth) only when the vector holds more than N elements.
+ * It is meant for the small sets of cells returned by the incident_* / adjacent_* functions, that are computed
+ * per cell in the hot loops of the algorithms: most of them never allocate.
+ * The conversion to std::vector is kept for the code that needs one (it allocates).
+ */
+template <typename T, uint32 N>
+class SmallVector
+{
+	static_assert(N > 0u, "SmallVector: inline capacity should not be 0");
+	static_assert(std::is_trivially_destructible_v<T>, "SmallVector: elements should be trivially destructible");
+
+	alignas(T) unsigned char inline_storage_[N * sizeof(T)];
+	T* data_;
+	uint32 size_;
+	uint32 capacity_;
+
+	inline T* inline_data()
+	{
+		return reinterpret_cast<T*>(inline_storage_);
+	}
+
+	void grow(uint32 capacity)
+	{
+		T* data = static_cast<T*>(::operator new(std::size_t(capacity) * sizeof(T)));
+		std::uninitialized_copy(data_, data_ + size_, data);
+		if (!is_inline())
+			::operator delete(data_);
+		data_ = data;
+		capacity_ = capacity;
+	}
+
+public:
+	using value_type = T;
+	using size_type = uint32;
+	using reference = T&;
+	using const_reference = const T&;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	inline SmallVector() : data_(inline_data()), size_(0u), capacity_(N)
+	{
+	}
+
+	inline SmallVector(std::initializer_list<T> l) : SmallVector()
+	{
+		reserve(uint32(l.size()));
+		std::uninitialized_copy(l.begin(), l.end(), data_);
+		size_ = uint32(l.size());
+	}
+
+	inline SmallVector(const SmallVector& other) : SmallVector()
+	{
+		*this = other;
+	}
+
+	inline SmallVector(SmallVector&& other) noexcept : SmallVector()
+	{
+		*this = std::move(other);
+	}
+
+	inline ~SmallVector()
+	{
+		if (!is_inline())
+			::operator delete(data_);
+	}
+
+	SmallVector& operator=(const SmallVector& other)
+	{
+		if (this != &other)
+		{
+			size_ = 0u;
+			reserve(other.size_);
+			std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+			size_ = other.size_;
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+		if (other.is_inline())
+		{
+			// the inline capacity is enough for the elements of an inline vector
+			std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+			size_ = other.size_;
+		}
+		else
+		{
+			// the heap storage is stolen
+			if (!is_inline())
+				::operator delete(data_);
+			data_ = other.data_;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.data_ = other.inline_data();
+			other.capacity_ = N;
+		}
+		other.size_ = 0u;
+		return *this;
+	}
+
+	inline operator std::vector<T>() const
+	{
+		return std::vector<T>(begin(), end());
+	}
+
+	// elements are stored inline (no heap allocation has been done)
+	inline bool is_inline() const
+	{
+		return data_ == reinterpret_cast<const T*>(inline_storage_);
+	}
+
+	inline uint32 size() const
+	{
+		return size_;
+	}
+
+	inline bool empty() const
+	{
+		return size_ == 0u;
+	}
+
+	inline uint32 capacity() const
+	{
+		return capacity_;
+	}
+
+	inline void reserve(uint32 capacity)
+	{
+		if (capacity > capacity_)
+			grow(capacity);
+	}
+
+	inline void clear()
+	{
+		size_ = 0u;
+	}
+
+	inline void push_back(const T& e)
+	{
+		if (size_ == capacity_)
+		{
+			// e may be an element of the vector
+			const T copy = e;
+			grow(2u * capacity_);
+			new (data_ + size_++) T(copy);
+		}
+		else
+			new (data_ + size_++) T(e);
+	}
+
+	template <typename... Args>
+	inline T& emplace_back(Args&&... args)
+	{
+		push_back(T(std::forward<Args>(args)...));
+		return back();
+	}
+
+	inline void pop_back()
+	{
+		cgogn_message_assert(size_ > 0u, "SmallVector: pop_back on an empty vector");
+		--size_;
+	}
+
+	inline T& operator[](uint32 i)
+	{
+		cgogn_message_assert(i < size_, "SmallVector: index out of bounds");
+		return data_[i];
+	}
+
+	inline const T& operator[](uint32 i) const
+	{
+		cgogn_message_assert(i < size_, "SmallVector: index out of bounds");
+		return data_[i];
+	}
+
+	inline T& front()
+	{
+		return (*this)[0u];
+	}
+
+	inline const T& front() const
+	{
+		return (*this)[0u];
+	}
+
+	inline T& back()
+	{
+		return (*this)[size_ - 1u];
+	}
+
+	inline const T& back() const
+	{
+		return (*this)[size_ - 1u];
+	}
+
+	inline T* data()
+	{
+		return data_;
+	}
+
+	inline const T* data() const
+	{
+		return data_;
+	}
+
+	inline iterator begin()
+	{
+		return data_;
+	}
+
+	inline iterator end()
+	{
+		return data_ + size_;
+	}
+
+	inline const_iterator begin() const
+	{
+		return data_;
+	}
+
+	inline const_iterator end() const
+	{
+		return data_ + size_;
+	}
+};
+
+// small vector returned by the incident_* / adjacent_* functions
+template <typename CELL>
+using CellsSmallVector = SmallVector<CELL, 8u>;
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_SMALL_VECTOR_H_
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#include <cgogn/core/utils/task_graph.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <deque>
+
+namespace cgogn
+{
+
+namespace internal
+{
+
+// functions scheduled while the pool has no working worker, run in order by the thread that scheduled them
+// (a continuation is not run by the task that enables it, to keep the stack depth bounded)
+static thread_local std::deque<std::function<void()>> inline_tasks_;
+static thread_local bool running_inline_tasks_ = false;
+
+static bool run_inline_task()
+{
+	if (inline_tasks_.empty())
+		return false;
+	std::function<void()> f = std::move(inline_tasks_.front());
+	inline_tasks_.pop_front();
+	f();
+	return true;
+}
+
+void schedule(std::function<void()> f)
+{
+	ThreadPool* pool = thread_pool();
+	if (pool->nb_workers() > 0)
+	{
+		pool->enqueue(f);
+		return;
+	}
+	inline_tasks_.push_back(std::move(f));
+	if (running_inline_tasks_)
+		return;
+	running_inline_tasks_ = true;
+	while (run_inline_task())
+		;
+	running_inline_tasks_ = false;
+}
+
+void TaskStateBase::on_done(std::function<void()> f)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!done_.load(std::memory_order_relaxed))
+		{
+			continuations_.push_back(std::move(f));
+			return;
+		}
+	}
+	f();
+}
+
+void TaskStateBase::finish(bool cancelled)
+{
+	complete(cancelled, nullptr);
+}
+
+void TaskStateBase::fail(std::exception_ptr exception)
+{
+	complete(false, std::move(exception));
+}
+
+void TaskStateBase::complete(bool cancelled, std::exception_ptr exception)
+{
+	std::vector<std::function<void()>> continuations;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		cancelled_ = cancelled;
+		exception_ = std::move(exception);
+		done_.store(true, std::memory_order_release);
+		continuations.swap(continuations_);
+	}
+	condition_done_.notify_all();
+	for (std::function<void()>& f : continuations)
+		f();
+}
+
+void TaskStateBase::wait()
+{
+	ThreadPool* pool = thread_pool();
+	while (!is_done())
+	{
+		// a worker (or the thread running the tasks when there is no worker) never blocks while there is work to do
+		if (pool->is_worker_thread() ? pool->run_pending_task() : run_inline_task())
+			continue;
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (pool->is_worker_thread())
+			condition_done_.wait_for(lock, std::chrono::microseconds(100), [this]() { return is_done(); });
+		else
+			condition_done_.wait(lock, [this]() { return is_done(); });
+	}
+}
+
+std::shared_ptr<TaskState<void>> when_all_states(const std::vector<std::shared_ptr<TaskStateBase>>& states)
+{
+	auto state = std::make_shared<TaskState<void>>();
+	if (states.empty())
+	{
+		state->finish(false);
+		return state;
+	}
+	struct Completion
+	{
+		std::atomic<uint32> nb_remaining;
+		std::atomic<bool> cancelled{false};
+		std::atomic<bool> failed{false};
+		std::exception_ptr exception; // written once, by the first failed state
+	};
+	auto completion = std::make_shared<Completion>();
+	completion->nb_remaining.store(uint32(states.size()), std::memory_order_relaxed);
+	for (const std::shared_ptr<TaskStateBase>& s : states)
+	{
+		s->on_done([state, s = s.get(), completion]() {
+			bool not_failed = false;
+			if (s->is_failed() && completion->failed.compare_exchange_strong(not_failed, true))
+				completion->exception = s->exception();
+			else if (s->is_cancelled())
+				completion->cancelled.store(true, std::memory_order_relaxed);
+			// the last one sees the writes of the others (acq_rel)
+			if (completion->nb_remaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+			{
+				if (completion->exception)
+					state->fail(completion->exception);
+				else
+					state->finish(completion->cancelled.load(std::memory_order_relaxed));
+			}
+		});
+	}
+	return state;
+}
+
+} // namespace internal
+
+Task<void> launch_pipeline(uint32 nb_items, const std::vector<PipelineStage>& stages, uint32 max_nb_items_in_flight,
+						   const CancellationToken& token)
+{
+	cgogn_message_assert(max_nb_items_in_flight > 0u, "A pipeline needs at least one item in flight");
+	const uint32 nb_stages = uint32(stages.size());
+	if (nb_items == 0u || nb_stages == 0u)
+		return when_all(std::vector<Task<void>>());
+
+	// last stage of each item (the item is out of the pipeline when it is done)
+	std::vector<Task<void>> outs;
+	outs.reserve(nb_items);
+	std::vector<Task<void>> previous_item(nb_stages);
+	std::vector<Task<void>> current_item(nb_stages);
+	for (uint32 i = 0u; i < nb_items; ++i)
+	{
+		for (uint32 s = 0u; s < nb_stages; ++s)
+		{
+			std::vector<Task<void>> dependencies;
+			if (s > 0u)
+				dependencies.push_back(current_item[s - 1u]);
+			else if (i >= max_nb_items_in_flight)
+				dependencies.push_back(outs[i - max_nb_items_in_flight]);
+			if (stages[s].serial && i > 0u)
+				dependencies.push_back(previous_item[s]);
+			const std::function<void(uint32)>& f = stages[s].f;
+			auto run = [f, i]() { f(i); };
+			current_item[s] = dependencies.empty() ? launch_task(run, token) : when_all(dependencies).then(run, token);
+		}
+		outs.push_back(current_item[nb_stages - 1u]);
+		previous_item.swap(current_item);
+	}
+	return when_all(outs);
+}
+
+} // namespace cgogn
@@ -0,0 +1,407 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_CORE_UTILS_TASK_GRAPH_H_
+#define CGOGN_CORE_UTILS_TASK_GRAPH_H_
+
+#include <cgogn/core/cgogn_core_export.h>
+
+#include <cgogn/core/utils/assert.h>
+#include <cgogn/core/utils/numerics.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace cgogn
+{
+
+/**
+ * Task graphs
+ * A Task is the handle of a function run asynchronously by the workers of the thread pool (see launch_task).
+ * Tasks are chained without blocking any thread: the continuations of a task (then, when_all) are enqueued
+ * as soon as it completes, so that independent branches of a graph run concurrently and no worker idles
+ * waiting for a predecessor. Waiting on a task from a worker runs the enqueued tasks meanwhile, so tasks can
+ * call the parallel algorithms (parallel_foreach_cell, ...) or wait for other tasks.
+ * A task that is cancelled (or depends on a cancelled task) has no value and its continuations are cancelled
+ * without being run. A task whose function throws an exception fails: the exception is stored and passed to its
+ * continuations (which are not run), and rethrown by wait and get.
+ * When the thread pool has no working worker, tasks are run on the thread that enqueues them.
+ */
+
+//////////////////////
+// Cancellation     //
+//////////////////////
+
+/**
+ * @brief read-only view of a CancellationSource
+ * A default constructed token is never cancelled. Tasks launched with a cancelled token are not run and
+ * long functions can poll is_cancelled to stop early.
+ */
+class CancellationToken
+{
+	std::shared_ptr<const std::atomic<bool>> cancelled_;
+
+public:
+	CancellationToken() = default;
+	explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> cancelled) : cancelled_(std::move(cancelled))
+	{
+	}
+
+	inline bool is_cancelled() const
+	{
+		return cancelled_ && cancelled_->load(std::memory_order_relaxed);
+	}
+};
+
+class CancellationSource
+{
+	std::shared_ptr<std::atomic<bool>> cancelled_;
+
+public:
+	CancellationSource() : cancelled_(std::make_shared<std::atomic<bool>>(false))
+	{
+	}
+
+	inline void cancel()
+	{
+		cancelled_->store(true, std::memory_order_relaxed);
+	}
+
+	inline bool is_cancelled() const
+	{
+		return cancelled_->load(std::memory_order_relaxed);
+	}
+
+	inline CancellationToken token() const
+	{
+		return CancellationToken(cancelled_);
+	}
+};
+
+/**
+ * @brief thrown when getting the value of a cancelled task
+ */
+class TaskCancelled : public std::runtime_error
+{
+public:
+	TaskCancelled() : std::runtime_error("Getting the value of a cancelled task")
+	{
+	}
+};
+
+namespace internal
+{
+
+class CGOGN_CORE_EXPORT TaskStateBase
+{
+public:
+	TaskStateBase() : done_(false), cancelled_(false)
+	{
+	}
+	virtual ~TaskStateBase()
+	{
+	}
+
+	inline bool is_done() const
+	{
+		return done_.load(std::memory_order_acquire);
+	}
+
+	inline bool is_cancelled() const
+	{
+		return cancelled_;
+	}
+
+	inline bool is_failed() const
+	{
+		return exception_ != nullptr;
+	}
+
+	inline const std::exception_ptr& exception() const
+	{
+		return exception_;
+	}
+
+	// call f when the task is done (immediately if it is already done)
+	void on_done(std::function<void()> f);
+
+	// set the task as done and schedule its continuations
+	void finish(bool cancelled);
+	// set the task as failed with the given exception and schedule its continuations
+	void fail(std::exception_ptr exception);
+
+	void wait();
+
+private:
+	void complete(bool cancelled, std::exception_ptr exception);
+
+	std::atomic<bool> done_;
+	bool cancelled_;
+	std::exception_ptr exception_;
+	std::mutex mutex_;
+	std::condition_variable condition_done_;
+	std::vector<std::function<void()>> continuations_;
+};
+
+template <typename T>
+class TaskState : public TaskStateBase
+{
+public:
+	std::optional<T> value_;
+};
+
+template <>
+class TaskState<void> : public TaskStateBase
+{
+};
+
+// type of the value of the continuation FUNC of a Task<T>
+template <typename FUNC, typename T>
+struct continuation_result
+{
+	using type = std::invoke_result_t<FUNC, const T&>;
+};
+
+template <typename FUNC>
+struct continuation_result<FUNC, void>
+{
+	using type = std::invoke_result_t<FUNC>;
+};
+
+// enqueue f in the thread pool (or run it on the calling thread if the pool has no working worker)
+CGOGN_CORE_EXPORT void schedule(std::function<void()> f);
+
+// state completed when all the given states are done
+// (failed with the first exception if one of them failed, cancelled if one of them is cancelled)
+CGOGN_CORE_EXPORT std::shared_ptr<TaskState<void>> when_all_states(
+	const std::vector<std::shared_ptr<TaskStateBase>>& states);
+
+// run f (with the given arguments) and complete state with its result
+template <typename T, typename FUNC, typename... Args>
+void run_task_function(TaskState<T>& state, const CancellationToken& token, const FUNC& f, const Args&... args)
+{
+	if (token.is_cancelled())
+	{
+		state.finish(true);
+		return;
+	}
+	try
+	{
+		if constexpr (std::is_void_v<T>)
+			f(args...);
+		else
+			state.value_.emplace(f(args...));
+	}
+	catch (...)
+	{
+		state.fail(std::current_exception());
+		return;
+	}
+	state.finish(false);
+}
+
+// complete next as previous if previous could not complete
+// @return true if previous completed
+inline bool forward_incompletion(const TaskStateBase& previous, TaskStateBase& next)
+{
+	if (previous.is_failed())
+		next.fail(previous.exception());
+	else if (previous.is_cancelled())
+		next.finish(true);
+	else
+		return true;
+	return false;
+}
+
+} // namespace internal
+
+//////////////
+// Task     //
+//////////////
+
+template <typename T>
+class Task
+{
+	std::shared_ptr<internal::TaskState<T>> state_;
+
+	template <typename U>
+	friend class Task;
+
+	template <typename... T2>
+	friend Task<void> when_all(const Task<T2>&... tasks);
+	template <typename T2>
+	friend Task<void> when_all(const std::vector<Task<T2>>& tasks);
+
+public:
+	using value_type = T;
+
+	Task()
+	{
+	}
+	explicit Task(std::shared_ptr<internal::TaskState<T>> state) : state_(std::move(state))
+	{
+	}
+
+	inline bool valid() const
+	{
+		return state_ != nullptr;
+	}
+
+	inline bool is_ready() const
+	{
+		return state_->is_done();
+	}
+
+	// only meaningful once the task is ready
+	inline bool is_cancelled() const
+	{
+		return state_->is_cancelled();
+	}
+
+	// only meaningful once the task is ready
+	inline bool is_failed() const
+	{
+		return state_->is_failed();
+	}
+
+	/**
+	 * @brief wait for the task to be done
+	 * The exception of a failed task is rethrown.
+	 */
+	inline void wait() const
+	{
+		state_->wait();
+		if (state_->is_failed())
+			std::rethrow_exception(state_->exception());
+	}
+
+	/**
+	 * @brief wait for the task and get its value
+	 * The exception of a failed task is rethrown, TaskCancelled is thrown for a cancelled task.
+	 */
+	inline decltype(auto) get() const
+	{
+		wait();
+		if (state_->is_cancelled())
+			throw TaskCancelled();
+		if constexpr (!std::is_void_v<T>)
+			return static_cast<const T&>(*state_->value_);
+	}
+
+	/**
+	 * @brief launch f with the value of this task (or without parameter for a Task<void>) once it is done
+	 * If this task is cancelled (or failed), f is not run and the returned task is cancelled (or failed with the
+	 * same exception).
+	 */
+	template <typename FUNC>
+	auto then(const FUNC& f, const CancellationToken& token = CancellationToken()) const
+	{
+		using R = typename internal::continuation_result<FUNC, T>::type;
+		auto next = std::make_shared<internal::TaskState<R>>();
+		state_->on_done([previous = state_, next, f, token]() {
+			if (!internal::forward_incompletion(*previous, *next))
+				return;
+			internal::schedule([previous, next, f, token]() {
+				if constexpr (std::is_void_v<T>)
+					internal::run_task_function(*next, token, f);
+				else
+					internal::run_task_function(*next, token, f, *previous->value_);
+			});
+		});
+		return Task<R>(next);
+	}
+};
+
+/**
+ * @brief run f() asynchronously on the workers of the thread pool
+ */
+template <typename FUNC>
+auto launch_task(const FUNC& f, const CancellationToken& token = CancellationToken())
+{
+	using R = std::invoke_result_t<FUNC>;
+	auto state = std::make_shared<internal::TaskState<R>>();
+	internal::schedule([state, f, token]() { internal::run_task_function(*state, token, f); });
+	return Task<R>(state);
+}
+
+/**
+ * @brief a task done when all the given tasks are done
+ * (failed with the first exception if one of them failed, cancelled if one of them is cancelled)
+ * Nothing is enqueued: the returned task is completed by the last of the given tasks.
+ */
+template <typename... T>
+Task<void> when_all(const Task<T>&... tasks)
+{
+	return Task<void>(internal::when_all_states({tasks.state_...}));
+}
+
+template <typename T>
+Task<void> when_all(const std::vector<Task<T>>& tasks)
+{
+	std::vector<std::shared_ptr<internal::TaskStateBase>> states;
+	states.reserve(tasks.size());
+	for (const Task<T>& t : tasks)
+		states.push_back(t.state_);
+	return Task<void>(internal::when_all_states(states));
+}
+
+//////////////////
+// Pipeline     //
+//////////////////
+
+struct PipelineStage
+{
+	// called with the index of the item
+	std::function<void(uint32)> f;
+	// items go through a serial stage one at a time and in order
+	// (items go through a parallel stage concurrently and in any order)
+	bool serial;
+};
+
+/**
+ * @brief process the items 0 to nb_items - 1 through the given stages
+ * Stage s of item i starts when stage s - 1 of item i is done and, if stage s is serial, when stage s of item
+ * i - 1 is done. At most max_nb_items_in_flight items are in the pipeline at once: item i enters the pipeline
+ * when item i - max_nb_items_in_flight is out (which bounds the memory used by the intermediate results).
+ * The dependency graph is built at once (one small task per item and stage): items should be coarse.
+ * A cancelled (or failed) stage cancels (or fails) the stages that depend on it (the next stages of its item,
+ * the next items through the serial stages and the item limit), so that a cancellation or a failure stops the
+ * pipeline.
+ * @return a task done when all items are out of the pipeline (failed or cancelled if a stage was)
+ */
+CGOGN_CORE_EXPORT Task<void> launch_pipeline(uint32 nb_items, const std::vector<PipelineStage>& stages,
+											 uint32 max_nb_items_in_flight,
+											 const CancellationToken& token = CancellationToken());
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_TASK_GRAPH_H_
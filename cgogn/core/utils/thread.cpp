@@ -24,6 +24,9 @@
 #include <cgogn/core/utils/thread.h>
 #include <cgogn/core/utils/thread_pool.h>
 
+#include <algorithm>
+#include <mutex>
+
 namespace cgogn
 {
 
@@ -33,6 +36,19 @@ CGOGN_TLS Buffers<uint32>* uint32_buffers_thread_ = nullptr;
 CGOGN_TLS uint32 uint32_value_ = 0;
 CGOGN_TLS float64 float64_value_ = 0.0;
 
+// buffers of all started threads, for the memory reports
+// (never destroyed: the workers of the static thread pool stop after the other statics are destroyed)
+static std::mutex& thread_buffers_mutex()
+{
+	static std::mutex* mutex = new std::mutex();
+	return *mutex;
+}
+static std::vector<Buffers<uint32>*>& thread_buffers()
+{
+	static std::vector<Buffers<uint32>*>* buffers = new std::vector<Buffers<uint32>*>();
+	return *buffers;
+}
+
 CGOGN_CORE_EXPORT uint32& uint32_value()
 {
 	return uint32_value_;
@@ -46,11 +62,23 @@ CGOGN_CORE_EXPORT void thread_start(uint32 index)
 {
 	thread_index_ = index;
 	if (uint32_buffers_thread_ == nullptr)
+	{
 		uint32_buffers_thread_ = new Buffers<uint32>();
+		std::lock_guard<std::mutex> lock(thread_buffers_mutex());
+		thread_buffers().push_back(uint32_buffers_thread_);
+	}
 }
 
 CGOGN_CORE_EXPORT void thread_stop()
 {
+	if (uint32_buffers_thread_ != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(thread_buffers_mutex());
+		std::vector<Buffers<uint32>*>& buffers = thread_buffers();
+		auto it = std::find(buffers.begin(), buffers.end(), uint32_buffers_thread_);
+		if (it != buffers.end())
+			buffers.erase(it);
+	}
 	delete uint32_buffers_thread_;
 	uint32_buffers_thread_ = nullptr;
 }
@@ -77,4 +105,17 @@ CGOGN_CORE_EXPORT Buffers<uint32>* uint32_buffers()
 	return uint32_buffers_thread_;
 }
 
+CGOGN_CORE_EXPORT ThreadBuffersReport thread_buffers_report()
+{
+	ThreadBuffersReport report;
+	std::lock_guard<std::mutex> lock(thread_buffers_mutex());
+	for (const Buffers<uint32>* b : thread_buffers())
+	{
+		++report.nb_threads;
+		report.nb_used_buffers += b->nb_used_buffers();
+		report.pooled_bytes += b->memory_size();
+	}
+	return report;
+}
+
 } // namespace cgogn
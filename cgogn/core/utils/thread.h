@@ -66,6 +66,16 @@ CGOGN_CORE_EXPORT uint32 current_worker_index();
 
 CGOGN_CORE_EXPORT Buffers<uint32>* uint32_buffers();
 
+// memory of the buffers of the started threads (see thread_start)
+struct ThreadBuffersReport
+{
+	uint32 nb_threads = 0u;
+	uint32 nb_used_buffers = 0u;
+	std::size_t pooled_bytes = 0u;
+};
+
+CGOGN_CORE_EXPORT ThreadBuffersReport thread_buffers_report();
+
 template <typename F>
 void launch_thread(F f)
 {
@@ -106,6 +106,31 @@ void ThreadPool::set_nb_workers(uint32 nb)
 	std::cout << "ThreadPool now using " << nb_working_workers_ << " workers" << std::endl;
 }
 
+bool ThreadPool::run_pending_task()
+{
+	PackagedTask task;
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex_);
+		if (tasks_.empty())
+			return false;
+		task = std::move(tasks_.front());
+		tasks_.pop();
+	}
+#if defined(_MSC_VER) && _MSC_VER < 1900
+	(*task)();
+#else
+	task();
+#endif
+	return true;
+}
+
+bool ThreadPool::is_worker_thread() const
+{
+	// workers are started with indices 1 to workers_.size() (see constructor)
+	const uint32 index = current_thread_index();
+	return index >= 1u && index <= uint32(workers_.size());
+}
+
 ThreadPool* thread_pool()
 {
 	// thread safe according to
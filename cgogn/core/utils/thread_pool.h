@@ -61,6 +61,7 @@
 #include <cgogn/core/utils/definitions.h>
 #include <cgogn/core/utils/numerics.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
@@ -149,6 +150,36 @@ public:
 		return res;
 	}
 
+	/**
+	 * @brief run one of the enqueued tasks in the calling thread
+	 * @return false if there was no enqueued task
+	 */
+	bool run_pending_task();
+
+	// true if the calling thread is one of the workers of this pool
+	bool is_worker_thread() const;
+
+	/**
+	 * @brief wait for the task of the given future
+	 * When called from a worker (e.g. by a parallel algorithm called from a task), the enqueued tasks are run
+	 * while waiting: a worker never blocks while there is work to do, so that nested waits cannot starve the pool.
+	 */
+	template <typename T>
+	void wait(const std::future<T>& f)
+	{
+		if (!is_worker_thread())
+		{
+			f.wait();
+			return;
+		}
+		while (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			if (!run_pending_task())
+				f.wait_for(std::chrono::microseconds(100));
+		}
+	}
+
+	// all workers are blocked until each of them has run f: must not be called from a task
 	template <class FUNC>
 	void execute_all(const FUNC&& f)
 	{
@@ -24,6 +24,8 @@
 #ifndef CGOGN_CORE_UTILS_TYPE_TRAITS_H_
 #define CGOGN_CORE_UTILS_TYPE_TRAITS_H_
 
+#include <cgogn/core/utils/numerics.h>
+
 #include <functional>
 #include <tuple>
 
@@ -133,6 +135,29 @@ using func_return_type = typename internal::type_traits::function_traits<F>::res
 template <typename F, typename T>
 using is_func_return_same = std::is_same<func_return_type<F>, T>;
 
+/**
+ * @brief identifier of the type T, without RTTI
+ * It is a hash of the signature of this function (which contains the name of T), so it is the same in all
+ * the libraries and executables, unlike the address of a per-type static variable.
+ */
+template <typename T>
+inline uint64 type_hash()
+{
+#if defined(_MSC_VER)
+	static const char* signature = __FUNCSIG__;
+#else
+	static const char* signature = __PRETTY_FUNCTION__;
+#endif
+	static const uint64 tag = [] {
+		// FNV-1a
+		uint64 h = 14695981039346656037ull;
+		for (const char* c = signature; *c != '\0'; ++c)
+			h = (h ^ uint64(uint8(*c))) * 1099511628211ull;
+		return h;
+	}();
+	return tag;
+}
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_UTILS_TYPE_TRAITS_H_
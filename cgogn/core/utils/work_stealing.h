@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_CORE_UTILS_WORK_STEALING_H_
+#define CGOGN_CORE_UTILS_WORK_STEALING_H_
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace cgogn
+{
+
+// number of consecutive indices taken at once from a range
+const uint32 WORK_STEALING_GRAIN_SIZE = 1024u;
+
+/**
+ * @brief a contiguous range of indices consumed from its front
+ * The owner and the thieves both take grains with an atomic fetch_add on next_,
+ * so stealing never needs a lock and never splits a grain.
+ * Each range lives on its own cache line to avoid false sharing between workers.
+ */
+struct alignas(64) WorkRange
+{
+	std::atomic<uint32> next_;
+	uint32 end_;
+
+	inline bool take(uint32 grain, uint32& begin, uint32& end)
+	{
+		// cheap check first to avoid incrementing next_ far beyond end_ once the range is exhausted
+		if (next_.load(std::memory_order_relaxed) >= end_)
+			return false;
+		begin = next_.fetch_add(grain, std::memory_order_relaxed);
+		if (begin >= end_)
+			return false;
+		end = std::min(begin + grain, end_);
+		return true;
+	}
+};
+
+/**
+ * @brief a value alone on its cache line(s)
+ * Used for partial results updated concurrently by several workers, to avoid false sharing.
+ */
+template <typename T>
+struct alignas(64) CacheLinePadded
+{
+	T value;
+};
+
+/**
+ * @brief apply f on sub-ranges of [first, last) with the workers of the thread pool
+ * The index range is split into one contiguous range per worker. Each worker consumes
+ * its own range grain by grain and, once done, steals grains from the ranges of the other workers.
+ * No work is produced by the calling thread, which only waits for the workers to finish
+ * (a worker calling it, e.g. from a task, runs the enqueued tasks while waiting: see ThreadPool::wait).
+ * @param f a callable with signature void(uint32 begin, uint32 end)
+ * @param grain the number of indices given at once to f
+ */
+template <typename FUNC>
+void parallel_foreach_range(uint32 first, uint32 last, const FUNC& f, uint32 grain = WORK_STEALING_GRAIN_SIZE)
+{
+	if (first >= last)
+		return;
+
+	ThreadPool* pool = thread_pool();
+	uint32 nb_workers = pool->nb_workers();
+	if (nb_workers == 0)
+	{
+		f(first, last);
+		return;
+	}
+
+	const uint32 nb_grains = (last - first + grain - 1u) / grain;
+	nb_workers = std::min(nb_workers, nb_grains);
+
+	std::unique_ptr<WorkRange[]> ranges = std::make_unique<WorkRange[]>(nb_workers);
+	const uint32 grains_per_worker = nb_grains / nb_workers;
+	const uint32 remaining_grains = nb_grains % nb_workers;
+	uint32 begin = first;
+	for (uint32 i = 0u; i < nb_workers; ++i)
+	{
+		const uint32 size = (grains_per_worker + (i < remaining_grains ? 1u : 0u)) * grain;
+		ranges[i].next_.store(begin, std::memory_order_relaxed);
+		ranges[i].end_ = std::min(begin + size, last);
+		begin = ranges[i].end_;
+	}
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(nb_workers);
+	for (uint32 i = 0u; i < nb_workers; ++i)
+	{
+		futures.push_back(pool->enqueue([&ranges, &f, nb_workers, grain, i]() {
+			uint32 b, e;
+			// own range first, then steal from the next ones
+			for (uint32 k = 0u; k < nb_workers; ++k)
+			{
+				WorkRange& r = ranges[(i + k) % nb_workers];
+				while (r.take(grain, b, e))
+					f(b, e);
+			}
+		}));
+	}
+	for (auto& fu : futures)
+		pool->wait(fu);
+}
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_WORK_STEALING_H_
@@ -69,14 +69,14 @@ Scalar angle(const MESH& m, typename mesh_traits<MESH>::Edge e,
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Face = typename mesh_traits<MESH>::Face;
 
-	std::vector<Face> faces = incident_faces(m, e);
+	CellsSmallVector<Face> faces = incident_faces(m, e);
 	if (uint32(faces.size()) < 2)
 		return 0;
 
 	const Vec3 n1 = normal(m, faces[0], vertex_position);
 	const Vec3 n2 = normal(m, faces[1], vertex_position);
 
-	std::vector<Vertex> vertices = incident_vertices(m, e);
+	CellsSmallVector<Vertex> vertices = incident_vertices(m, e);
 	Vec3 edge = value<Vec3>(m, vertex_position, vertices[1]) - value<Vec3>(m, vertex_position, vertices[0]);
 	edge.normalize();
 	Scalar s = edge.dot(n1.cross(n2));
@@ -112,7 +112,7 @@ Scalar angle(const MESH& m, typename mesh_traits<MESH>::Edge e,
 	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
 
 	using Face = typename mesh_traits<MESH>::Face;
-	std::vector<Face> faces = incident_faces(m, e);
+	CellsSmallVector<Face> faces = incident_faces(m, e);
 	if (uint32(faces.size()) < 2)
 		return 0;
 	return angle(value<Vec3>(m, face_normal, faces[0]), value<Vec3>(m, face_normal, faces[1]));
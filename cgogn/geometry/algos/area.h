@@ -29,6 +29,8 @@
 #include <cgogn/core/functions/attributes.h>
 #include <cgogn/core/functions/mesh_info.h>
 #include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/types/derived_attribute.h>
 
 #include <cgogn/geometry/algos/centroid.h>
 #include <cgogn/geometry/functions/area.h>
@@ -40,49 +42,73 @@ namespace cgogn
 namespace geometry
 {
 
-template <typename MESH>
-Scalar convex_area(const MESH& m, typename mesh_traits<MESH>::Face f,
-				   const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+template <typename VEC = Vec3, typename MESH>
+typename vector_traits<VEC>::Scalar convex_area(
+	const MESH& m, typename mesh_traits<MESH>::Face f,
+	const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using FaceScalar = typename vector_traits<VEC>::Scalar;
 	if (codegree(m, f) == 3)
 	{
-		std::vector<Vertex> vertices = incident_vertices(m, f);
-		return area(value<Vec3>(m, vertex_position, vertices[0]), value<Vec3>(m, vertex_position, vertices[1]),
-					value<Vec3>(m, vertex_position, vertices[2]));
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
+		return area(value<VEC>(m, vertex_position, vertices[0]), value<VEC>(m, vertex_position, vertices[1]),
+					value<VEC>(m, vertex_position, vertices[2]));
 	}
 	else
 	{
-		Scalar face_area{0};
-		Vec3 center = centroid<Vec3>(m, f, vertex_position);
-		std::vector<Vertex> vertices = incident_vertices(m, f);
+		FaceScalar face_area{0};
+		VEC center = centroid<VEC>(m, f, vertex_position);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
 		for (uint32 i = 0, size = uint32(vertices.size()); i < size; ++i)
 		{
-			face_area += area(center, value<Vec3>(m, vertex_position, vertices[i]),
-							  value<Vec3>(m, vertex_position, vertices[(i + 1) % size]));
+			face_area += area(center, value<VEC>(m, vertex_position, vertices[i]),
+							  value<VEC>(m, vertex_position, vertices[(i + 1) % size]));
 		}
 		return face_area;
 	}
 }
 
-template <typename MESH>
-Scalar area(const MESH& m, typename mesh_traits<MESH>::Face f,
-			const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+template <typename VEC = Vec3, typename MESH>
+typename vector_traits<VEC>::Scalar area(const MESH& m, typename mesh_traits<MESH>::Face f,
+										 const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
-	return convex_area(m, f, vertex_position);
+	return convex_area<VEC>(m, f, vertex_position);
 }
 
-template <typename MESH>
-Scalar area(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+// the sum is accumulated in float64 whatever the scalar type of the positions
+template <typename VEC = Vec3, typename MESH>
+Scalar area(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	using Face = typename mesh_traits<MESH>::Face;
 
-	Scalar result = 0;
-	foreach_cell(m, [&](Face f) -> bool {
-		result += area(m, f, vertex_position);
-		return true;
-	});
-	return result;
+	return parallel_transform_reduce_cell(m, Scalar(0), std::plus<Scalar>(),
+										  [&](Face f) -> Scalar { return Scalar(area<VEC>(m, f, vertex_position)); });
+}
+
+/**
+ * @brief face areas of the given vertex position, shared by all their users
+ * The derived attribute is named after the position ("<position>_face_area") and is only recomputed
+ * (by its update function) for the faces whose vertices were modified (see DerivedAttribute).
+ */
+template <typename VEC = Vec3, typename MESH>
+std::shared_ptr<DerivedAttribute<MESH, typename mesh_traits<MESH>::Face, typename vector_traits<VEC>::Scalar>>
+face_area_derived_attribute(
+	MESH& m, const std::shared_ptr<typename mesh_traits<MESH>::template Attribute<VEC>>& vertex_position)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using Face = typename mesh_traits<MESH>::Face;
+	using FaceScalar = typename vector_traits<VEC>::Scalar;
+	const std::string name = vertex_position->name() + "_face_area";
+	auto face_area = get_derived_attribute<FaceScalar, Face>(m, name);
+	if (!face_area)
+	{
+		face_area = add_derived_attribute<FaceScalar, Face>(
+			m, name, [&m, vp = vertex_position.get()](Face f) -> FaceScalar { return area<VEC>(m, f, vp); });
+		if (face_area)
+			face_area->template add_input<Vertex>(vertex_position);
+	}
+	return face_area;
 }
 
 } // namespace geometry
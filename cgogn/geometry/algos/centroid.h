@@ -58,21 +58,25 @@ VEC centroid(const MESH& m, CELL c, const typename mesh_traits<MESH>::template A
 	return result;
 }
 
+// the sum is accumulated in float64 whatever the scalar type of the values
 template <typename VEC, typename MESH>
 VEC centroid(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_attribute)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Scalar = typename vector_traits<VEC>::Scalar;
-	VEC result;
-	result.setZero();
-	uint32 count = 0;
-	foreach_cell(m, [&](Vertex v) -> bool {
-		result += value<VEC>(m, vertex_attribute, v);
-		++count;
-		return true;
-	});
-	result /= Scalar(count);
-	return result;
+	// sum of the values & number of vertices
+	using ValueSum = std::pair<AccumulationVec<VEC>, uint32>;
+	ValueSum zero;
+	zero.first.setZero();
+	zero.second = 0u;
+	ValueSum sum = parallel_reduce_cell(
+		m, zero,
+		[&](ValueSum& acc, Vertex v) {
+			acc.first += value<VEC>(m, vertex_attribute, v).template cast<float64>();
+			++acc.second;
+		},
+		[](ValueSum a, ValueSum b) { return ValueSum(a.first + b.first, a.second + b.second); });
+	return (sum.first / float64(sum.second)).template cast<Scalar>();
 }
 
 template <typename VEC, typename CELL, typename MESH,
@@ -62,7 +62,7 @@ std::tuple<Scalar, Scalar, Vec3, Vec3, Vec3> curvature(
 	tensor.setZero();
 
 	foreach_cell(neighborhood, [&](Edge e) -> bool {
-		std::vector<Vertex> vv = incident_vertices(m, e);
+		CellsSmallVector<Vertex> vv = incident_vertices(m, e);
 		Vec3 ev = value<Vec3>(m, vertex_position, vv[1]) - value<Vec3>(m, vertex_position, vv[0]);
 		tensor += (ev * ev.transpose()) * value<Scalar>(m, edge_angle, e) * (Scalar(1) / ev.norm());
 		return true;
@@ -71,7 +71,7 @@ std::tuple<Scalar, Scalar, Vec3, Vec3, Vec3> curvature(
 	const Vec3& p = value<Vec3>(m, vertex_position, v);
 	foreach_cell(neighborhood, [&](HalfEdge h) -> bool {
 		Edge e = incident_edges(m, h)[0];
-		std::vector<Vertex> vv = incident_vertices(m, e);
+		CellsSmallVector<Vertex> vv = incident_vertices(m, e);
 		const Vec3& p1 = value<Vec3>(m, vertex_position, vv[0]);
 		const Vec3& p2 = value<Vec3>(m, vertex_position, vv[1]);
 		Vec3 ev = p2 - p1;
@@ -84,7 +84,7 @@ std::tuple<Scalar, Scalar, Vec3, Vec3, Vec3> curvature(
 	Scalar neighborhood_area = area(neighborhood, vertex_position);
 	foreach_cell(neighborhood, [&](HalfEdge h) -> bool {
 		Face f = incident_faces(m, h)[0];
-		std::vector<Vertex> vv = incident_vertices(m, f);
+		CellsSmallVector<Vertex> vv = incident_vertices(m, f);
 		const Vec3& p1 = value<Vec3>(m, vertex_position, vv[0]);
 		const Vec3& p2 = value<Vec3>(m, vertex_position, vv[1]);
 		const Vec3& p3 = value<Vec3>(m, vertex_position, vv[2]);
@@ -50,7 +50,7 @@ Vec3 closest_point_on_surface(const MESH& m,
 	Scalar min_dist = std::numeric_limits<Scalar>::max();
 
 	foreach_cell(m, [&](Face f) -> bool {
-		std::vector<Vertex> vertices = incident_vertices(m, f);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
 		// std::vector<const Vec3*> vertices_position;
 		// std::transform(vertices.begin(), vertices.end(), std::back_inserter(vertices_position),
 		// 			   [&](Vertex v) -> const Vec3* { return &value<Vec3>(m, vertex_position, v); });
@@ -85,7 +85,7 @@ Vec3 closest_point_on_surface(const MESH& m,
 	Scalar min_dist = std::numeric_limits<Scalar>::max();
 
 	g.foreach_face_around(p, [&](Face f) {
-		std::vector<Vertex> vertices = incident_vertices(m, f);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
 		// std::vector<const Vec3*> vertices_position;
 		// std::transform(vertices.begin(), vertices.end(), std::back_inserter(vertices_position),
 		// 			   [&](Vertex v) -> const Vec3* { return &value<Vec3>(m, vertex_position, v); });
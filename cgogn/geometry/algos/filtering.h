@@ -42,6 +42,7 @@ void filter_average(const MESH& m, const typename mesh_traits<MESH>::template At
 					typename mesh_traits<MESH>::template Attribute<T>* attribute_out)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using Scalar = typename vector_traits<T>::Scalar;
 	parallel_foreach_cell(m, [&](Vertex v) -> bool {
 		T sum;
 		sum.setZero();
@@ -51,7 +52,7 @@ void filter_average(const MESH& m, const typename mesh_traits<MESH>::template At
 			++count;
 			return true;
 		});
-		value<T>(m, attribute_out, v) = sum / count;
+		value<T>(m, attribute_out, v) = sum / Scalar(count);
 		return true;
 	});
 }
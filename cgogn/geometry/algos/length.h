@@ -27,6 +27,7 @@
 #include <cgogn/core/functions/attributes.h>
 #include <cgogn/core/functions/traversals/edge.h>
 #include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/types/derived_attribute.h>
 #include <cgogn/core/types/mesh_traits.h>
 
 #include <cgogn/geometry/types/vector_traits.h>
@@ -37,42 +38,57 @@ namespace cgogn
 namespace geometry
 {
 
-template <typename MESH>
-Scalar length(const MESH& m, typename mesh_traits<MESH>::Edge e,
-			  const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+template <typename VEC = Vec3, typename MESH>
+typename vector_traits<VEC>::Scalar length(const MESH& m, typename mesh_traits<MESH>::Edge e,
+										   const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices = incident_vertices(m, e);
-	return (value<Vec3>(m, vertex_position, vertices[0]) - value<Vec3>(m, vertex_position, vertices[1])).norm();
+	CellsSmallVector<Vertex> vertices = incident_vertices(m, e);
+	return (value<VEC>(m, vertex_position, vertices[0]) - value<VEC>(m, vertex_position, vertices[1])).norm();
 }
 
-template <typename MESH>
-Scalar mean_edge_length(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+// the sum is accumulated in float64 whatever the scalar type of the positions
+template <typename VEC = Vec3, typename MESH>
+Scalar mean_edge_length(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	using Edge = typename mesh_traits<MESH>::Edge;
 
-	thread_pool()->execute_all([]() {
-		float64_value() = 0.0;
-		uint32_value() = 0;
-	});
+	// sum of the lengths & number of edges
+	using LengthSum = std::pair<Scalar, uint32>;
+	LengthSum sum = parallel_reduce_cell(
+		m, LengthSum(0.0, 0u),
+		[&](LengthSum& acc, Edge e) {
+			acc.first += length<VEC>(m, e, vertex_position);
+			++acc.second;
+		},
+		[](LengthSum a, LengthSum b) { return LengthSum(a.first + b.first, a.second + b.second); });
 
-	parallel_foreach_cell(m, [&](Edge e) -> bool {
-		float64_value() += length(m, e, vertex_position);
-		++uint32_value();
-		return true;
-	});
-
-	Scalar length_sum = 0.0;
-	uint32 nbe = 0;
-
-	std::mutex mutex;
-	thread_pool()->execute_all([&]() {
-		std::lock_guard<std::mutex> lock(mutex);
-		length_sum += float64_value();
-		nbe += uint32_value();
-	});
+	return sum.first / Scalar(sum.second);
+}
 
-	return length_sum / Scalar(nbe);
+/**
+ * @brief edge lengths of the given vertex position, shared by all their users
+ * The derived attribute is named after the position ("<position>_edge_length") and is only recomputed
+ * (by its update function) for the edges whose vertices were modified (see DerivedAttribute).
+ */
+template <typename VEC = Vec3, typename MESH>
+std::shared_ptr<DerivedAttribute<MESH, typename mesh_traits<MESH>::Edge, typename vector_traits<VEC>::Scalar>>
+edge_length_derived_attribute(
+	MESH& m, const std::shared_ptr<typename mesh_traits<MESH>::template Attribute<VEC>>& vertex_position)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using Edge = typename mesh_traits<MESH>::Edge;
+	using EdgeScalar = typename vector_traits<VEC>::Scalar;
+	const std::string name = vertex_position->name() + "_edge_length";
+	auto edge_length = get_derived_attribute<EdgeScalar, Edge>(m, name);
+	if (!edge_length)
+	{
+		edge_length = add_derived_attribute<EdgeScalar, Edge>(
+			m, name, [&m, vp = vertex_position.get()](Edge e) -> EdgeScalar { return length<VEC>(m, e, vp); });
+		if (edge_length)
+			edge_length->template add_input<Vertex>(vertex_position);
+	}
+	return edge_length;
 }
 
 } // namespace geometry
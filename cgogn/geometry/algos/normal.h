@@ -28,6 +28,7 @@
 #include <cgogn/core/functions/traversals/face.h>
 #include <cgogn/core/functions/traversals/global.h>
 #include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/types/derived_attribute.h>
 #include <cgogn/core/types/mesh_traits.h>
 
 #include <cgogn/geometry/functions/normal.h>
@@ -39,28 +40,28 @@ namespace cgogn
 namespace geometry
 {
 
-template <typename MESH>
-Vec3 normal(const MESH& m, typename mesh_traits<MESH>::Face f,
-			const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+template <typename VEC = Vec3, typename MESH>
+VEC normal(const MESH& m, typename mesh_traits<MESH>::Face f,
+		   const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	static_assert(mesh_traits<MESH>::dimension >= 2, "MESH dimension should be >= 2");
 
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices = incident_vertices(m, f);
+	CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
 	if (uint32(vertices.size()) == 3)
 	{
-		Vec3 n = normal(value<Vec3>(m, vertex_position, vertices[0]), value<Vec3>(m, vertex_position, vertices[1]),
-						value<Vec3>(m, vertex_position, vertices[2]));
+		VEC n = normal(value<VEC>(m, vertex_position, vertices[0]), value<VEC>(m, vertex_position, vertices[1]),
+					   value<VEC>(m, vertex_position, vertices[2]));
 		n.normalize();
 		return n;
 	}
 	else
 	{
-		Vec3 n{0.0, 0.0, 0.0};
+		VEC n = VEC::Zero();
 		for (uint32 i = 0, nb = uint32(vertices.size()); i < nb; ++i)
 		{
-			const Vec3& p = value<Vec3>(m, vertex_position, vertices[i]);
-			const Vec3& q = value<Vec3>(m, vertex_position, vertices[(i + 1) % nb]);
+			const VEC& p = value<VEC>(m, vertex_position, vertices[i]);
+			const VEC& q = value<VEC>(m, vertex_position, vertices[(i + 1) % nb]);
 			n[0] += (p[1] - q[1]) * (p[2] + q[2]);
 			n[1] += (p[2] - q[2]) * (p[0] + q[0]);
 			n[2] += (p[0] - q[0]) * (p[1] + q[1]);
@@ -70,26 +71,26 @@ Vec3 normal(const MESH& m, typename mesh_traits<MESH>::Face f,
 	}
 }
 
-template <typename MESH>
-Vec3 normal(const MESH& m, typename mesh_traits<MESH>::Face2 f,
-			const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+template <typename VEC = Vec3, typename MESH>
+VEC normal(const MESH& m, typename mesh_traits<MESH>::Face2 f,
+		   const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices = incident_vertices(m, f);
+	CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
 	if (uint32(vertices.size()) == 3)
 	{
-		Vec3 n = normal(value<Vec3>(m, vertex_position, vertices[0]), value<Vec3>(m, vertex_position, vertices[1]),
-						value<Vec3>(m, vertex_position, vertices[2]));
+		VEC n = normal(value<VEC>(m, vertex_position, vertices[0]), value<VEC>(m, vertex_position, vertices[1]),
+					   value<VEC>(m, vertex_position, vertices[2]));
 		n.normalize();
 		return n;
 	}
 	else
 	{
-		Vec3 n{0.0, 0.0, 0.0};
+		VEC n = VEC::Zero();
 		for (uint32 i = 0, nb = uint32(vertices.size()); i < nb; ++i)
 		{
-			const Vec3& p = value<Vec3>(m, vertex_position, vertices[i]);
-			const Vec3& q = value<Vec3>(m, vertex_position, vertices[(i + 1) % nb]);
+			const VEC& p = value<VEC>(m, vertex_position, vertices[i]);
+			const VEC& q = value<VEC>(m, vertex_position, vertices[(i + 1) % nb]);
 			n[0] += (p[1] - q[1]) * (p[2] + q[2]);
 			n[1] += (p[2] - q[2]) * (p[0] + q[0]);
 			n[2] += (p[0] - q[0]) * (p[1] + q[1]);
@@ -99,15 +100,15 @@ Vec3 normal(const MESH& m, typename mesh_traits<MESH>::Face2 f,
 	}
 }
 
-template <typename MESH>
-Vec3 normal(const MESH& m, typename mesh_traits<MESH>::Vertex v,
-			const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+template <typename VEC = Vec3, typename MESH>
+VEC normal(const MESH& m, typename mesh_traits<MESH>::Vertex v,
+		   const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
 {
 	static_assert(mesh_traits<MESH>::dimension >= 2, "MESH dimension should be >= 2");
 
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Face = typename mesh_traits<MESH>::Face;
-	Vec3 n{0.0, 0.0, 0.0};
+	VEC n = VEC::Zero();
 	// const Vec3& p = value<Vec3>(m, vertex_position, v);
 	// std::vector<Vertex> adjacent_vertices = adjacent_vertices_through_edge(m, v);
 	// for (uint32 i = 0, nb = uint32(adjacent_vertices.size()); i < nb; ++i)
@@ -117,26 +118,88 @@ Vec3 normal(const MESH& m, typename mesh_traits<MESH>::Vertex v,
 	// 			 .normalized();
 	// }
 	foreach_incident_face(m, v, [&](Face f) -> bool {
-		n += normal(m, f, vertex_position);
+		n += normal<VEC>(m, f, vertex_position);
 		return true;
 	});
 	n.normalize();
 	return n;
 }
 
-template <typename MESH>
-void compute_normal(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position,
-					typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_normal)
+template <typename VEC = Vec3, typename MESH>
+void compute_normal(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position,
+					typename mesh_traits<MESH>::template Attribute<VEC>* vertex_normal)
 {
 	static_assert(mesh_traits<MESH>::dimension >= 2, "MESH dimension should be >= 2");
 
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	parallel_foreach_cell(m, [&](Vertex v) -> bool {
-		value<Vec3>(m, vertex_normal, v) = normal(m, v, vertex_position);
+		value<VEC>(m, vertex_normal, v) = normal<VEC>(m, v, vertex_position);
 		return true;
 	});
 }
 
+/**
+ * @brief face normals of the given vertex position, shared by all their users
+ * The derived attribute is named after the position ("<position>_face_normal") and is only recomputed
+ * (by its update function) for the faces whose vertices were modified (see DerivedAttribute).
+ * nullptr is returned if an attribute of this name that is not derived already exists.
+ */
+template <typename VEC = Vec3, typename MESH>
+std::shared_ptr<DerivedAttribute<MESH, typename mesh_traits<MESH>::Face, VEC>> face_normal_derived_attribute(
+	MESH& m, const std::shared_ptr<typename mesh_traits<MESH>::template Attribute<VEC>>& vertex_position)
+{
+	static_assert(mesh_traits<MESH>::dimension >= 2, "MESH dimension should be >= 2");
+
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using Face = typename mesh_traits<MESH>::Face;
+	const std::string name = vertex_position->name() + "_face_normal";
+	auto face_normal = get_derived_attribute<VEC, Face>(m, name);
+	if (!face_normal)
+	{
+		face_normal = add_derived_attribute<VEC, Face>(
+			m, name, [&m, vp = vertex_position.get()](Face f) -> VEC { return normal<VEC>(m, f, vp); });
+		if (face_normal)
+			face_normal->template add_input<Vertex>(vertex_position);
+	}
+	return face_normal;
+}
+
+/**
+ * @brief vertex normals of the given vertex position, shared by all their users
+ * Vertex normals are computed from the (derived) face normals, so that each face normal is computed once
+ * and not once per incident vertex (see face_normal_derived_attribute).
+ */
+template <typename VEC = Vec3, typename MESH>
+std::shared_ptr<DerivedAttribute<MESH, typename mesh_traits<MESH>::Vertex, VEC>> vertex_normal_derived_attribute(
+	MESH& m, const std::shared_ptr<typename mesh_traits<MESH>::template Attribute<VEC>>& vertex_position)
+{
+	static_assert(mesh_traits<MESH>::dimension >= 2, "MESH dimension should be >= 2");
+
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using Face = typename mesh_traits<MESH>::Face;
+	const std::string name = vertex_position->name() + "_vertex_normal";
+	auto vertex_normal = get_derived_attribute<VEC, Vertex>(m, name);
+	if (!vertex_normal)
+	{
+		auto face_normal = face_normal_derived_attribute<VEC>(m, vertex_position);
+		if (!face_normal)
+			return nullptr;
+		vertex_normal = add_derived_attribute<VEC, Vertex>(
+			m, name, [&m, fn = face_normal->attribute().get()](Vertex v) -> VEC {
+				VEC n = VEC::Zero();
+				foreach_incident_face(m, v, [&](Face f) -> bool {
+					n += value<VEC>(m, fn, f);
+					return true;
+				});
+				n.normalize();
+				return n;
+			});
+		if (vertex_normal)
+			vertex_normal->template add_input<Face>(face_normal);
+	}
+	return vertex_normal;
+}
+
 } // namespace geometry
 
 } // namespace cgogn
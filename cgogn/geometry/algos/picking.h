@@ -30,6 +30,7 @@
 
 #include <cgogn/geometry/functions/distance.h>
 #include <cgogn/geometry/functions/intersection.h>
+#include <cgogn/geometry/types/bvh.h>
 #include <cgogn/geometry/types/vector_traits.h>
 
 namespace cgogn
@@ -41,9 +42,10 @@ namespace geometry
 namespace internal
 {
 
-template <typename MESH>
+// the positions may be of any scalar type: the intersections are computed in float64 (as the ray)
+template <typename VEC = Vec3, typename MESH>
 std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>> picking(
-	const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position, const Vec3& A,
+	const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position, const Vec3& A,
 	const Vec3& B)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
@@ -54,31 +56,27 @@ std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>> picking(
 	cgogn_message_assert(AB.squaredNorm() > 0.0, "line must be defined by 2 different points");
 	AB.normalize();
 
-	std::vector<std::vector<SelectedFace>> selected_per_thread(thread_pool()->nb_workers());
+	auto position = [&](Vertex v) -> Vec3 { return value<VEC>(m, vertex_position, v).template cast<Scalar>(); };
+
 	// std::vector<std::vector<uint32>> ear_indices_per_thread(thread_pool()->nb_workers());
 
-	parallel_foreach_cell(m, [&](Face f) -> bool {
-		uint32 worker_index = current_worker_index();
+	auto select_face = [&](std::vector<SelectedFace>& selected, Face f) {
 		Vec3 intersection_point;
-		std::vector<Vertex> vertices = incident_vertices(m, f);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, f);
 		if (vertices.size() == 3)
 		{
-			if (intersection_ray_triangle(A, AB, value<Vec3>(m, vertex_position, vertices[0]),
-										  value<Vec3>(m, vertex_position, vertices[1]),
-										  value<Vec3>(m, vertex_position, vertices[2]), &intersection_point))
-				selected_per_thread[worker_index].emplace_back(f, intersection_point,
-															   (intersection_point - A).squaredNorm());
+			if (intersection_ray_triangle(A, AB, position(vertices[0]), position(vertices[1]), position(vertices[2]),
+										  &intersection_point))
+				selected.emplace_back(f, intersection_point, (intersection_point - A).squaredNorm());
 		}
 		else
 		{
 			for (uint32 i = 0, size = uint32(vertices.size()); i + 2 < size; i++)
 			{
-				if (intersection_ray_triangle(A, AB, value<Vec3>(m, vertex_position, vertices[0]),
-											  value<Vec3>(m, vertex_position, vertices[i + 1]),
-											  value<Vec3>(m, vertex_position, vertices[i + 2]), &intersection_point))
+				if (intersection_ray_triangle(A, AB, position(vertices[0]), position(vertices[i + 1]),
+											  position(vertices[i + 2]), &intersection_point))
 				{
-					selected_per_thread[worker_index].emplace_back(f, intersection_point,
-																   (intersection_point - A).squaredNorm());
+					selected.emplace_back(f, intersection_point, (intersection_point - A).squaredNorm());
 					break;
 				}
 			}
@@ -95,19 +93,19 @@ std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>> picking(
 		// 		const VEC3& p3 = position[ear_indices[i+2]];
 		// 		if (intersection_ray_triangle(A, AB, p1, p2, p3, &intersection_point))
 		// 		{
-		// 			selected_per_thread[worker_index].push_back({ f, intersection_point, (intersection_point -
+		// 			selected.push_back({ f, intersection_point, (intersection_point -
 		// A).squaredNorm() }); 			i = uint32(ear_indices.size());
 		// 		}
 		// 	}
 		// }
-		return true;
-	});
-
-	std::vector<SelectedFace> result;
+	};
 
-	for (const auto& selected_faces_vector : selected_per_thread)
-		for (const auto& x : selected_faces_vector)
-			result.push_back(x);
+	std::vector<SelectedFace> result =
+		parallel_reduce_cell(m, std::vector<SelectedFace>(), select_face,
+							 [](std::vector<SelectedFace> a, std::vector<SelectedFace> b) {
+								 a.insert(a.end(), b.begin(), b.end());
+								 return a;
+							 });
 
 	std::sort(result.begin(), result.end(),
 			  [](const SelectedFace& f1, const SelectedFace& f2) -> bool { return std::get<2>(f1) < std::get<2>(f2); });
@@ -115,17 +113,14 @@ std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>> picking(
 	return result;
 }
 
-} // namespace internal
-
-template <typename MESH>
-void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position, const Vec3& A,
-			 const Vec3& B, std::vector<typename mesh_traits<MESH>::Vertex>& result)
+// keep the vertex of each selected face that is the closest to the intersection point
+template <typename VEC = Vec3, typename MESH>
+void picked_vertices(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position,
+					 const std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>>& selected_faces,
+					 std::vector<typename mesh_traits<MESH>::Vertex>& result)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Face = typename mesh_traits<MESH>::Face;
-	using SelectedFace = std::tuple<Face, Vec3, Scalar>;
-
-	std::vector<SelectedFace> selected_faces = internal::picking(m, vertex_position, A, B);
 
 	CellMarkerStore<MESH, Vertex> cm(m);
 	result.clear();
@@ -139,7 +134,7 @@ void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute
 		const Vec3& I = std::get<1>(sf);
 
 		foreach_incident_vertex(m, f, [&](Vertex v) -> bool {
-			Scalar d2 = (value<Vec3>(m, vertex_position, v) - I).squaredNorm();
+			Scalar d2 = (value<VEC>(m, vertex_position, v).template cast<Scalar>() - I).squaredNorm();
 			if (d2 < min_d2)
 			{
 				min_d2 = d2;
@@ -156,16 +151,15 @@ void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute
 	}
 }
 
-template <typename MESH>
-void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position, const Vec3& A,
-			 const Vec3& B, std::vector<typename mesh_traits<MESH>::Edge>& result)
+// keep the edge of each selected face that is the closest to the intersection point
+template <typename VEC = Vec3, typename MESH>
+void picked_edges(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position,
+				  const std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>>& selected_faces,
+				  std::vector<typename mesh_traits<MESH>::Edge>& result)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Edge = typename mesh_traits<MESH>::Edge;
 	using Face = typename mesh_traits<MESH>::Face;
-	using SelectedFace = std::tuple<Face, Vec3, Scalar>;
-
-	std::vector<SelectedFace> selected_faces = internal::picking(m, vertex_position, A, B);
 
 	CellMarkerStore<MESH, Edge> cm(m);
 	result.clear();
@@ -179,9 +173,10 @@ void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute
 		const Vec3& I = std::get<1>(sf);
 
 		foreach_incident_edge(m, f, [&](Edge e) -> bool {
-			std::vector<Vertex> vertices = incident_vertices(m, e);
-			Scalar d2 = squared_distance_line_point(value<Vec3>(m, vertex_position, vertices[0]),
-													value<Vec3>(m, vertex_position, vertices[1]), I);
+			CellsSmallVector<Vertex> vertices = incident_vertices(m, e);
+			Scalar d2 = squared_distance_line_point(value<VEC>(m, vertex_position, vertices[0]).template cast<Scalar>(),
+													value<VEC>(m, vertex_position, vertices[1]).template cast<Scalar>(),
+													I);
 			if (d2 < min_d2)
 			{
 				min_d2 = d2;
@@ -199,20 +194,62 @@ void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute
 }
 
 template <typename MESH>
-void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position, const Vec3& A,
-			 const Vec3& B, std::vector<typename mesh_traits<MESH>::Face>& result)
+void picked_faces(const std::vector<std::tuple<typename mesh_traits<MESH>::Face, Vec3, Scalar>>& selected_faces,
+				  std::vector<typename mesh_traits<MESH>::Face>& result)
 {
-	using Face = typename mesh_traits<MESH>::Face;
-	using SelectedFace = std::tuple<Face, Vec3, Scalar>;
-
-	std::vector<SelectedFace> selected_faces = internal::picking(m, vertex_position, A, B);
-
 	result.clear();
 	result.reserve(selected_faces.size());
 	for (const auto& sf : selected_faces)
 		result.push_back(std::get<0>(sf));
 }
 
+} // namespace internal
+
+template <typename VEC = Vec3, typename MESH>
+void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position, const Vec3& A,
+			 const Vec3& B, std::vector<typename mesh_traits<MESH>::Vertex>& result)
+{
+	internal::picked_vertices<VEC>(m, vertex_position, internal::picking<VEC>(m, vertex_position, A, B), result);
+}
+
+template <typename VEC = Vec3, typename MESH>
+void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position, const Vec3& A,
+			 const Vec3& B, std::vector<typename mesh_traits<MESH>::Edge>& result)
+{
+	internal::picked_edges<VEC>(m, vertex_position, internal::picking<VEC>(m, vertex_position, A, B), result);
+}
+
+template <typename VEC = Vec3, typename MESH>
+void picking(const MESH& m, const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position, const Vec3& A,
+			 const Vec3& B, std::vector<typename mesh_traits<MESH>::Face>& result)
+{
+	internal::picked_faces<MESH>(internal::picking<VEC>(m, vertex_position, A, B), result);
+}
+
+// same as above with the faces hit by the ray found in a BVH instead of testing all the faces of the mesh
+// (only the boundary faces of a volume mesh are stored in the BVH)
+
+template <typename MESH>
+void picking(const BVH<MESH>& bvh, const Vec3& A, const Vec3& B,
+			 std::vector<typename mesh_traits<MESH>::Vertex>& result)
+{
+	internal::picked_vertices(bvh.mesh(), bvh.vertex_position(), bvh.all_hits(A, B), result);
+}
+
+template <typename MESH>
+void picking(const BVH<MESH>& bvh, const Vec3& A, const Vec3& B,
+			 std::vector<typename mesh_traits<MESH>::Edge>& result)
+{
+	internal::picked_edges(bvh.mesh(), bvh.vertex_position(), bvh.all_hits(A, B), result);
+}
+
+template <typename MESH>
+void picking(const BVH<MESH>& bvh, const Vec3& A, const Vec3& B,
+			 std::vector<typename mesh_traits<MESH>::Face>& result)
+{
+	internal::picked_faces<MESH>(bvh.all_hits(A, B), result);
+}
+
 } // namespace geometry
 
 } // namespace cgogn
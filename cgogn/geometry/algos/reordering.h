@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#ifndef CGOGN_GEOMETRY_ALGOS_REORDERING_H_
+#define CGOGN_GEOMETRY_ALGOS_REORDERING_H_
+
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/reordering.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/utils/work_stealing.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+// position along the 3D Hilbert curve of the point of integer coordinates x (21 bits each), using
+// Skilling's transposition ("Programming the Hilbert curve", 2004)
+inline uint64 hilbert_key(uint32 x[3])
+{
+	const uint32 M = 1u << 20u;
+	for (uint32 q = M; q > 1u; q >>= 1u)
+	{
+		const uint32 p = q - 1u;
+		for (uint32 i = 0u; i < 3u; ++i)
+		{
+			if (x[i] & q)
+				x[0] ^= p;
+			else
+			{
+				const uint32 t = (x[0] ^ x[i]) & p;
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+	x[1] ^= x[0];
+	x[2] ^= x[1];
+	uint32 t = 0u;
+	for (uint32 q = M; q > 1u; q >>= 1u)
+	{
+		if (x[2] & q)
+			t ^= q - 1u;
+	}
+	uint64 key = 0u;
+	for (int32 b = 20; b >= 0; --b)
+	{
+		for (uint32 i = 0u; i < 3u; ++i)
+			key = (key << 1u) | (((x[i] ^ t) >> b) & 1u);
+	}
+	return key;
+}
+
+/**
+ * @brief compute an order of the vertices along a Hilbert curve traversing the bounding box of the vertex_position
+ * Vertices that are close in space get close indices (to be given to reorder_cells).
+ * @return the vertices indices in their new order
+ */
+template <typename VEC, typename MESH>
+auto hilbert_vertex_order(const MESH& m,
+						  const typename mesh_traits<MESH>::template Attribute<VEC>* vertex_position)
+	-> std::enable_if_t<std::is_convertible_v<MESH&, CMapBase&>, std::vector<uint32>>
+{
+	static_assert(vector_traits<VEC>::SIZE == 2 || vector_traits<VEC>::SIZE == 3, "VEC must be of dimension 2 or 3");
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+
+	std::vector<uint32> vertices_indices;
+	vertices_indices.reserve(maximum_index<Vertex>(m));
+	VEC bb_min, bb_max;
+	bb_min.setConstant(std::numeric_limits<typename vector_traits<VEC>::Scalar>::max());
+	bb_max.setConstant(std::numeric_limits<typename vector_traits<VEC>::Scalar>::lowest());
+	foreach_cell(m, [&](Vertex v) -> bool {
+		const VEC& p = value<VEC>(m, vertex_position, v);
+		bb_min = bb_min.cwiseMin(p);
+		bb_max = bb_max.cwiseMax(p);
+		vertices_indices.push_back(index_of(m, v));
+		return true;
+	});
+
+	// the bounding box is mapped on a cube of 2^21 cells per side (same scale on all axes)
+	const double extent = double((bb_max - bb_min).maxCoeff());
+	const double scale = extent > 0.0 ? double((1u << 21u) - 1u) / extent : 0.0;
+	std::vector<std::pair<uint64, uint32>> keys(vertices_indices.size());
+	parallel_foreach_range(0u, uint32(vertices_indices.size()), [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+		{
+			const VEC& p = (*vertex_position)[vertices_indices[i]];
+			uint32 x[3] = {0u, 0u, 0u};
+			for (uint32 j = 0u; j < uint32(vector_traits<VEC>::SIZE); ++j)
+				x[j] = uint32(double(p[j] - bb_min[j]) * scale);
+			keys[i] = {hilbert_key(x), vertices_indices[i]};
+		}
+	});
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<uint32> vertex_order(keys.size());
+	for (uint32 i = 0u, nb = uint32(keys.size()); i < nb; ++i)
+		vertex_order[i] = keys[i].second;
+	return vertex_order;
+}
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_REORDERING_H_
@@ -32,8 +32,10 @@ namespace cgogn
 namespace geometry
 {
 
-inline Scalar area(const Vec3& a, const Vec3& b, const Vec3& c)
+template <typename VEC>
+inline typename vector_traits<VEC>::Scalar area(const VEC& a, const VEC& b, const VEC& c)
 {
+	using Scalar = typename vector_traits<VEC>::Scalar;
 	return (Scalar(0.5) * ((b - a).cross(c - a)).norm());
 }
 
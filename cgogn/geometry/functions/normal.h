@@ -35,7 +35,8 @@ namespace geometry
 /**
  * normal of the plane spanned by 3 points in 3D
  */
-inline Vec3 normal(const Vec3& p1, const Vec3& p2, const Vec3& p3)
+template <typename VEC>
+inline VEC normal(const VEC& p1, const VEC& p2, const VEC& p3)
 {
 	return (p2 - p1).cross(p3 - p1);
 }
@@ -0,0 +1,821 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_TYPES_BVH_H_
+#define CGOGN_GEOMETRY_TYPES_BVH_H_
+
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/work_stealing.h>
+
+#include <cgogn/geometry/functions/distance.h>
+#include <cgogn/geometry/functions/intersection.h>
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * @brief bounding volume hierarchy of the faces of a surface (CMap2) or of the boundary faces of a volume mesh (CMap3)
+ * The tree is built top-down with the surface area heuristic (binned on the centroids of the faces bounding boxes),
+ * the subtrees being built in parallel by the workers of the thread pool.
+ * Nodes are 32 bytes (single precision bounding box, rounded outwards, and two indices) and the faces are stored
+ * in the order of the leaves, with the indices of their vertices, so that queries never traverse the mesh.
+ * Polygonal faces are intersected as fans of triangles.
+ * refit() updates the bounding boxes after the vertex positions have changed; rebuild() must be called
+ * after a modification of the topology of the mesh.
+ */
+template <typename MESH>
+class BVH
+{
+	template <typename T>
+	using Attribute = typename mesh_traits<MESH>::template Attribute<T>;
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using Face = typename mesh_traits<MESH>::Face;
+
+public:
+	using SelectedFace = std::tuple<Face, Vec3, Scalar>;
+
+private:
+	using Vec3f = std::array<float32, 3>;
+
+	struct Box
+	{
+		Vec3f min;
+		Vec3f max;
+	};
+
+	struct Node
+	{
+		Vec3f bb_min;
+		uint32 index; // inner node: index of the first child (the second one follows), leaf: index of the first face
+		Vec3f bb_max;
+		uint32 nb_faces; // 0 for an inner node
+	};
+
+	static constexpr uint32 NB_BINS = 16u;
+	static constexpr uint32 MAX_LEAF_SIZE = 8u;
+	static constexpr uint32 MAX_DEPTH = 60u;
+
+	const MESH& mesh_;
+	std::shared_ptr<Attribute<Vec3>> vertex_position_;
+
+	std::vector<Node> nodes_;
+	std::vector<Face> faces_;
+	// the vertices of the face i are face_vertices_[face_offsets_[i]] .. face_vertices_[face_offsets_[i + 1] - 1]
+	std::vector<uint32> face_offsets_;
+	std::vector<uint32> face_vertices_;
+	std::vector<Box> face_boxes_;
+
+	static inline float32 round_down(Scalar x)
+	{
+		float32 f = float32(x);
+		return Scalar(f) > x ? std::nextafter(f, std::numeric_limits<float32>::lowest()) : f;
+	}
+
+	static inline float32 round_up(Scalar x)
+	{
+		float32 f = float32(x);
+		return Scalar(f) < x ? std::nextafter(f, std::numeric_limits<float32>::max()) : f;
+	}
+
+	static inline Box empty_box()
+	{
+		return {{std::numeric_limits<float32>::max(), std::numeric_limits<float32>::max(),
+				 std::numeric_limits<float32>::max()},
+				{std::numeric_limits<float32>::lowest(), std::numeric_limits<float32>::lowest(),
+				 std::numeric_limits<float32>::lowest()}};
+	}
+
+	static inline void merge(Box& b, const Box& other)
+	{
+		for (uint32 i = 0u; i < 3u; ++i)
+		{
+			b.min[i] = std::min(b.min[i], other.min[i]);
+			b.max[i] = std::max(b.max[i], other.max[i]);
+		}
+	}
+
+	static inline float32 half_area(const Box& b)
+	{
+		const float32 dx = b.max[0] - b.min[0];
+		const float32 dy = b.max[1] - b.min[1];
+		const float32 dz = b.max[2] - b.min[2];
+		return dx * dy + dy * dz + dz * dx;
+	}
+
+	static inline float32 centroid(const Box& b, uint32 axis)
+	{
+		return 0.5f * (b.min[axis] + b.max[axis]);
+	}
+
+	inline const Vec3& position(uint32 vertex_index) const
+	{
+		return (*vertex_position_)[vertex_index];
+	}
+
+	inline Box face_box(uint32 f) const
+	{
+		Box b = empty_box();
+		for (uint32 k = face_offsets_[f], end = face_offsets_[f + 1u]; k < end; ++k)
+		{
+			const Vec3& p = position(face_vertices_[k]);
+			for (uint32 i = 0u; i < 3u; ++i)
+			{
+				b.min[i] = std::min(b.min[i], round_down(p[i]));
+				b.max[i] = std::max(b.max[i], round_up(p[i]));
+			}
+		}
+		return b;
+	}
+
+	/*************************************************************************/
+	// construction
+	/*************************************************************************/
+
+	// split the faces [begin, end) of faces_order: returns the split position (begin or end for a leaf)
+	uint32 split(std::vector<uint32>& faces_order, uint32 begin, uint32 end, const Box& box, uint32 depth) const
+	{
+		const uint32 nb = end - begin;
+		if (nb <= 1u)
+			return end;
+
+		Box centroids_box = empty_box();
+		for (uint32 i = begin; i < end; ++i)
+		{
+			const Box& b = face_boxes_[faces_order[i]];
+			for (uint32 a = 0u; a < 3u; ++a)
+			{
+				centroids_box.min[a] = std::min(centroids_box.min[a], centroid(b, a));
+				centroids_box.max[a] = std::max(centroids_box.max[a], centroid(b, a));
+			}
+		}
+
+		auto bin_of = [&](const Box& b, uint32 axis) -> uint32 {
+			const float32 extent = centroids_box.max[axis] - centroids_box.min[axis];
+			const uint32 bin = uint32(NB_BINS * ((centroid(b, axis) - centroids_box.min[axis]) / extent));
+			return std::min(bin, NB_BINS - 1u);
+		};
+
+		float32 best_cost = std::numeric_limits<float32>::max();
+		uint32 best_axis = 0u;
+		uint32 best_bin = 0u;
+		for (uint32 axis = 0u; axis < 3u; ++axis)
+		{
+			if (!(centroids_box.max[axis] > centroids_box.min[axis]))
+				continue;
+
+			std::array<Box, NB_BINS> bins_boxes;
+			std::array<uint32, NB_BINS> bins_counts;
+			bins_boxes.fill(empty_box());
+			bins_counts.fill(0u);
+			for (uint32 i = begin; i < end; ++i)
+			{
+				const Box& b = face_boxes_[faces_order[i]];
+				const uint32 bin = bin_of(b, axis);
+				merge(bins_boxes[bin], b);
+				++bins_counts[bin];
+			}
+
+			// cost of the split after bin i: left sweep then right sweep
+			std::array<float32, NB_BINS - 1u> left_costs;
+			Box left_box = empty_box();
+			uint32 left_count = 0u;
+			for (uint32 i = 0u; i < NB_BINS - 1u; ++i)
+			{
+				merge(left_box, bins_boxes[i]);
+				left_count += bins_counts[i];
+				left_costs[i] = left_count > 0u ? left_count * half_area(left_box) : 0.0f;
+			}
+			Box right_box = empty_box();
+			uint32 right_count = 0u;
+			for (uint32 i = NB_BINS - 1u; i > 0u; --i)
+			{
+				merge(right_box, bins_boxes[i]);
+				right_count += bins_counts[i];
+				if (right_count == 0u || right_count == nb)
+					continue;
+				const float32 cost = left_costs[i - 1u] + right_count * half_area(right_box);
+				if (cost < best_cost)
+				{
+					best_cost = cost;
+					best_axis = axis;
+					best_bin = i;
+				}
+			}
+		}
+
+		const bool found = best_cost < std::numeric_limits<float32>::max();
+		const float32 area = half_area(box);
+		const bool leaf_is_cheaper = !found || (area > 0.0f && 1.0f + best_cost / area >= float32(nb));
+		if (nb <= MAX_LEAF_SIZE && leaf_is_cheaper)
+			return end;
+
+		if (!found || depth >= MAX_DEPTH)
+		{
+			// identical centroids or degenerate tree: median split on the largest extent
+			uint32 axis = 0u;
+			for (uint32 a = 1u; a < 3u; ++a)
+				if (box.max[a] - box.min[a] > box.max[axis] - box.min[axis])
+					axis = a;
+			const uint32 middle = begin + nb / 2u;
+			std::nth_element(faces_order.begin() + begin, faces_order.begin() + middle, faces_order.begin() + end,
+							 [&](uint32 f1, uint32 f2) {
+								 return centroid(face_boxes_[f1], axis) < centroid(face_boxes_[f2], axis);
+							 });
+			return middle;
+		}
+
+		return uint32(std::partition(faces_order.begin() + begin, faces_order.begin() + end,
+									 [&](uint32 f) { return bin_of(face_boxes_[f], best_axis) < best_bin; }) -
+					  faces_order.begin());
+	}
+
+	Box range_box(const std::vector<uint32>& faces_order, uint32 begin, uint32 end) const
+	{
+		Box b = empty_box();
+		for (uint32 i = begin; i < end; ++i)
+			merge(b, face_boxes_[faces_order[i]]);
+		return b;
+	}
+
+	static inline void set_box(Node& n, const Box& b)
+	{
+		n.bb_min = b.min;
+		n.bb_max = b.max;
+	}
+
+	// build the subtree of the node n (already in nodes) on the faces [begin, end) of faces_order
+	void build_subtree(std::vector<Node>& nodes, uint32 n, std::vector<uint32>& faces_order, uint32 begin,
+					   uint32 end, uint32 depth) const
+	{
+		const Box box{nodes[n].bb_min, nodes[n].bb_max};
+		const uint32 middle = split(faces_order, begin, end, box, depth);
+		if (middle == begin || middle == end)
+		{
+			nodes[n].index = begin;
+			nodes[n].nb_faces = end - begin;
+			return;
+		}
+		const uint32 first_child = uint32(nodes.size());
+		nodes[n].index = first_child;
+		nodes[n].nb_faces = 0u;
+		nodes.resize(nodes.size() + 2u);
+		set_box(nodes[first_child], range_box(faces_order, begin, middle));
+		set_box(nodes[first_child + 1u], range_box(faces_order, middle, end));
+		build_subtree(nodes, first_child, faces_order, begin, middle, depth + 1u);
+		build_subtree(nodes, first_child + 1u, faces_order, middle, end, depth + 1u);
+	}
+
+	void build_tree()
+	{
+		const uint32 nb_faces = uint32(faces_.size());
+
+		face_boxes_.resize(nb_faces);
+		parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+			for (uint32 f = begin; f < end; ++f)
+				face_boxes_[f] = face_box(f);
+		});
+
+		std::vector<uint32> faces_order(nb_faces);
+		for (uint32 f = 0u; f < nb_faces; ++f)
+			faces_order[f] = f;
+
+		nodes_.clear();
+		nodes_.resize(1u);
+		set_box(nodes_[0], range_box(faces_order, 0u, nb_faces));
+		nodes_[0].index = 0u;
+		nodes_[0].nb_faces = nb_faces;
+		if (nb_faces == 0u)
+			return;
+
+		// the top of the tree is built sequentially until there are enough subtrees to keep the workers busy
+		struct Subtree
+		{
+			uint32 node;
+			uint32 begin;
+			uint32 end;
+			uint32 depth;
+			std::vector<Node> nodes;
+		};
+		const uint32 subtree_size = std::max(nb_faces / (8u * std::max(thread_pool()->nb_workers(), 1u)), 1024u);
+		std::vector<Subtree> subtrees;
+		std::vector<Subtree> stack;
+		stack.push_back({0u, 0u, nb_faces, 0u, {}});
+		while (!stack.empty())
+		{
+			Subtree s = std::move(stack.back());
+			stack.pop_back();
+			if (s.end - s.begin <= subtree_size)
+			{
+				subtrees.push_back(std::move(s));
+				continue;
+			}
+			const Box box{nodes_[s.node].bb_min, nodes_[s.node].bb_max};
+			const uint32 middle = split(faces_order, s.begin, s.end, box, s.depth);
+			if (middle == s.begin || middle == s.end)
+			{
+				nodes_[s.node].index = s.begin;
+				nodes_[s.node].nb_faces = s.end - s.begin;
+				continue;
+			}
+			const uint32 first_child = uint32(nodes_.size());
+			nodes_[s.node].index = first_child;
+			nodes_[s.node].nb_faces = 0u;
+			nodes_.resize(nodes_.size() + 2u);
+			set_box(nodes_[first_child], range_box(faces_order, s.begin, middle));
+			set_box(nodes_[first_child + 1u], range_box(faces_order, middle, s.end));
+			stack.push_back({first_child + 1u, middle, s.end, s.depth + 1u, {}});
+			stack.push_back({first_child, s.begin, middle, s.depth + 1u, {}});
+		}
+
+		parallel_foreach_range(
+			0u, uint32(subtrees.size()),
+			[&](uint32 begin, uint32 end) {
+				for (uint32 i = begin; i < end; ++i)
+				{
+					Subtree& s = subtrees[i];
+					s.nodes.push_back(nodes_[s.node]);
+					build_subtree(s.nodes, 0u, faces_order, s.begin, s.end, s.depth);
+				}
+			},
+			1u);
+
+		// the root of a subtree takes the place of its node, the other nodes are appended (shifted by offset - 1)
+		for (Subtree& s : subtrees)
+		{
+			const uint32 offset = uint32(nodes_.size()) - 1u;
+			for (Node& n : s.nodes)
+			{
+				if (n.nb_faces == 0u)
+					n.index += offset;
+			}
+			nodes_[s.node] = s.nodes[0];
+			nodes_.insert(nodes_.end(), s.nodes.begin() + 1, s.nodes.end());
+		}
+
+		// store the faces in the order of the leaves
+		std::vector<Face> faces(nb_faces);
+		std::vector<uint32> face_offsets(nb_faces + 1u);
+		std::vector<uint32> face_vertices(face_vertices_.size());
+		std::vector<Box> face_boxes(nb_faces);
+		face_offsets[0] = 0u;
+		for (uint32 i = 0u; i < nb_faces; ++i)
+		{
+			const uint32 f = faces_order[i];
+			face_offsets[i + 1u] = face_offsets[i] + face_offsets_[f + 1u] - face_offsets_[f];
+		}
+		parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+			{
+				const uint32 f = faces_order[i];
+				faces[i] = faces_[f];
+				face_boxes[i] = face_boxes_[f];
+				std::copy(face_vertices_.begin() + face_offsets_[f], face_vertices_.begin() + face_offsets_[f + 1u],
+						  face_vertices.begin() + face_offsets[i]);
+			}
+		});
+		faces_.swap(faces);
+		face_offsets_.swap(face_offsets);
+		face_vertices_.swap(face_vertices);
+		face_boxes_.swap(face_boxes);
+	}
+
+	/*************************************************************************/
+	// queries
+	/*************************************************************************/
+
+	// entry distance of the ray in the box of node n (infinity if the ray misses the box or enters it after t_max)
+	static inline Scalar ray_box_entry(const Node& n, const Vec3& origin, const Vec3& inv_dir, Scalar t_max)
+	{
+		// slab test written on the 3 axes without branches so that it is vectorized
+		// (a NaN coming from a zero direction component on a slab plane is discarded by the min/max order)
+		Scalar t_enter = 0.0;
+		Scalar t_exit = t_max;
+		for (uint32 i = 0u; i < 3u; ++i)
+		{
+			const Scalar t1 = (Scalar(n.bb_min[i]) - origin[i]) * inv_dir[i];
+			const Scalar t2 = (Scalar(n.bb_max[i]) - origin[i]) * inv_dir[i];
+			t_enter = std::max(t_enter, std::min(t1, t2));
+			t_exit = std::min(t_exit, std::max(t1, t2));
+		}
+		return t_enter <= t_exit ? t_enter : std::numeric_limits<Scalar>::infinity();
+	}
+
+	static inline Scalar squared_distance_to_box(const Node& n, const Vec3& p)
+	{
+		Scalar d2 = 0.0;
+		for (uint32 i = 0u; i < 3u; ++i)
+		{
+			const Scalar d = std::max({Scalar(n.bb_min[i]) - p[i], Scalar(0), p[i] - Scalar(n.bb_max[i])});
+			d2 += d * d;
+		}
+		return d2;
+	}
+
+	// intersection of the ray with the fan of triangles of the face f (same rule as internal::picking)
+	inline bool intersect_face(uint32 f, const Vec3& A, const Vec3& dir, Vec3& I) const
+	{
+		const uint32 first = face_offsets_[f];
+		const Vec3& p0 = position(face_vertices_[first]);
+		for (uint32 k = first + 1u, end = face_offsets_[f + 1u]; k + 1u < end; ++k)
+		{
+			if (intersection_ray_triangle(A, dir, p0, position(face_vertices_[k]), position(face_vertices_[k + 1u]),
+										  &I))
+				return true;
+		}
+		return false;
+	}
+
+	inline Scalar squared_distance_to_face(uint32 f, const Vec3& P, Vec3& closest) const
+	{
+		Scalar min_d2 = std::numeric_limits<Scalar>::max();
+		const uint32 first = face_offsets_[f];
+		const Vec3& p0 = position(face_vertices_[first]);
+		for (uint32 k = first + 1u, end = face_offsets_[f + 1u]; k + 1u < end; ++k)
+		{
+			const Vec3& p1 = position(face_vertices_[k]);
+			const Vec3& p2 = position(face_vertices_[k + 1u]);
+			Scalar u, v, w;
+			closest_point_in_triangle(P, p0, p1, p2, u, v, w);
+			const Vec3 Q = u * p0 + v * p1 + w * p2;
+			const Scalar d2 = (Q - P).squaredNorm();
+			if (d2 < min_d2)
+			{
+				min_d2 = d2;
+				closest = Q;
+			}
+		}
+		return min_d2;
+	}
+
+	// apply f on the index of the faces of the leaves whose box satisfies the node predicate
+	template <typename NODE_PREDICATE, typename FUNC>
+	void foreach_face_in_nodes(const NODE_PREDICATE& node_predicate, const FUNC& f) const
+	{
+		if (faces_.empty())
+			return;
+		std::vector<uint32> stack;
+		stack.reserve(2u * MAX_DEPTH);
+		stack.push_back(0u);
+		while (!stack.empty())
+		{
+			const Node& n = nodes_[stack.back()];
+			stack.pop_back();
+			if (!node_predicate(n))
+				continue;
+			if (n.nb_faces > 0u)
+			{
+				for (uint32 i = n.index, end = n.index + n.nb_faces; i < end; ++i)
+					if (!f(i))
+						return;
+			}
+			else
+			{
+				stack.push_back(n.index + 1u);
+				stack.push_back(n.index);
+			}
+		}
+	}
+
+public:
+	BVH(const MESH& m, const std::shared_ptr<Attribute<Vec3>>& vertex_position)
+		: mesh_(m), vertex_position_(vertex_position)
+	{
+		rebuild();
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(BVH);
+
+	inline const MESH& mesh() const
+	{
+		return mesh_;
+	}
+
+	inline const Attribute<Vec3>* vertex_position() const
+	{
+		return vertex_position_.get();
+	}
+
+	inline uint32 nb_faces() const
+	{
+		return uint32(faces_.size());
+	}
+
+	inline uint32 nb_nodes() const
+	{
+		return uint32(nodes_.size());
+	}
+
+	/**
+	 * @brief gather the faces of the mesh and build the tree
+	 */
+	void rebuild()
+	{
+		faces_.clear();
+		foreach_cell(mesh_, [&](Face f) -> bool {
+			if constexpr (mesh_traits<MESH>::dimension == 3)
+			{
+				if (!is_incident_to_boundary(mesh_, f))
+					return true;
+			}
+			faces_.push_back(f);
+			return true;
+		});
+
+		const uint32 nb_faces = uint32(faces_.size());
+		face_offsets_.assign(nb_faces + 1u, 0u);
+		parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+				face_offsets_[i + 1u] = codegree(mesh_, faces_[i]);
+		});
+		for (uint32 i = 0u; i < nb_faces; ++i)
+			face_offsets_[i + 1u] += face_offsets_[i];
+
+		face_vertices_.resize(face_offsets_.back());
+		parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+			{
+				uint32 k = face_offsets_[i];
+				foreach_incident_vertex(mesh_, faces_[i], [&](Vertex v) -> bool {
+					face_vertices_[k++] = index_of(mesh_, v);
+					return true;
+				});
+			}
+		});
+
+		build_tree();
+	}
+
+	/**
+	 * @brief update the bounding boxes of the nodes after a modification of the vertex positions
+	 * The structure of the tree is kept: its quality degrades if the faces move a lot.
+	 */
+	void refit()
+	{
+		const uint32 nb_faces = uint32(faces_.size());
+		parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+			for (uint32 f = begin; f < end; ++f)
+				face_boxes_[f] = face_box(f);
+		});
+		// children are stored after their parent
+		for (uint32 i = uint32(nodes_.size()); i-- > 0u;)
+		{
+			Node& n = nodes_[i];
+			Box b = empty_box();
+			if (n.nb_faces > 0u)
+			{
+				for (uint32 f = n.index, end = n.index + n.nb_faces; f < end; ++f)
+					merge(b, face_boxes_[f]);
+			}
+			else if (nb_faces > 0u)
+			{
+				merge(b, {nodes_[n.index].bb_min, nodes_[n.index].bb_max});
+				merge(b, {nodes_[n.index + 1u].bb_min, nodes_[n.index + 1u].bb_max});
+			}
+			set_box(n, b);
+		}
+	}
+
+	/**
+	 * @brief first face hit by the ray starting at A and going through B
+	 * @return false if no face is hit
+	 */
+	bool first_hit(const Vec3& A, const Vec3& B, Face& face, Vec3& intersection_point) const
+	{
+		Vec3 dir = B - A;
+		cgogn_message_assert(dir.squaredNorm() > 0.0, "line must be defined by 2 different points");
+		dir.normalize();
+		const Vec3 inv_dir = dir.cwiseInverse();
+
+		if (faces_.empty())
+			return false;
+
+		Scalar best_t = std::numeric_limits<Scalar>::max();
+		uint32 best_face = INVALID_INDEX;
+
+		std::vector<std::pair<uint32, Scalar>> stack;
+		stack.reserve(2u * MAX_DEPTH);
+		stack.emplace_back(0u, ray_box_entry(nodes_[0], A, inv_dir, best_t));
+		while (!stack.empty())
+		{
+			const auto [node, t_entry] = stack.back();
+			stack.pop_back();
+			if (t_entry > best_t)
+				continue;
+			const Node& n = nodes_[node];
+			if (n.nb_faces > 0u)
+			{
+				for (uint32 f = n.index, end = n.index + n.nb_faces; f < end; ++f)
+				{
+					Vec3 I;
+					if (intersect_face(f, A, dir, I))
+					{
+						const Scalar t = (I - A).dot(dir);
+						if (t < best_t)
+						{
+							best_t = t;
+							best_face = f;
+							intersection_point = I;
+						}
+					}
+				}
+			}
+			else
+			{
+				const Scalar t1 = ray_box_entry(nodes_[n.index], A, inv_dir, best_t);
+				const Scalar t2 = ray_box_entry(nodes_[n.index + 1u], A, inv_dir, best_t);
+				// the nearest child is visited first
+				if (t1 <= t2)
+				{
+					if (t2 <= best_t)
+						stack.emplace_back(n.index + 1u, t2);
+					if (t1 <= best_t)
+						stack.emplace_back(n.index, t1);
+				}
+				else
+				{
+					if (t1 <= best_t)
+						stack.emplace_back(n.index, t1);
+					if (t2 <= best_t)
+						stack.emplace_back(n.index + 1u, t2);
+				}
+			}
+		}
+
+		if (best_face == INVALID_INDEX)
+			return false;
+		face = faces_[best_face];
+		return true;
+	}
+
+	/**
+	 * @brief all the faces hit by the ray starting at A and going through B
+	 * @return the faces with their intersection point and its squared distance to A, sorted by this distance
+	 * (the same result as internal::picking)
+	 */
+	std::vector<SelectedFace> all_hits(const Vec3& A, const Vec3& B) const
+	{
+		Vec3 dir = B - A;
+		cgogn_message_assert(dir.squaredNorm() > 0.0, "line must be defined by 2 different points");
+		dir.normalize();
+		const Vec3 inv_dir = dir.cwiseInverse();
+
+		std::vector<SelectedFace> result;
+		foreach_face_in_nodes(
+			[&](const Node& n) {
+				return ray_box_entry(n, A, inv_dir, std::numeric_limits<Scalar>::max()) !=
+					   std::numeric_limits<Scalar>::infinity();
+			},
+			[&](uint32 f) -> bool {
+				Vec3 I;
+				if (intersect_face(f, A, dir, I))
+					result.emplace_back(faces_[f], I, (I - A).squaredNorm());
+				return true;
+			});
+
+		std::sort(result.begin(), result.end(), [](const SelectedFace& f1, const SelectedFace& f2) -> bool {
+			return std::get<2>(f1) < std::get<2>(f2);
+		});
+
+		return result;
+	}
+
+	/**
+	 * @brief face closest to P (within max_distance) and the closest point of this face
+	 * @return false if there is no face within max_distance
+	 */
+	bool closest_point(const Vec3& P, Face& face, Vec3& closest,
+					   Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+	{
+		if (faces_.empty())
+			return false;
+
+		Scalar best_d2 = max_distance < std::numeric_limits<Scalar>::max() ? max_distance * max_distance
+																			 : std::numeric_limits<Scalar>::max();
+		uint32 best_face = INVALID_INDEX;
+
+		std::vector<std::pair<uint32, Scalar>> stack;
+		stack.reserve(2u * MAX_DEPTH);
+		stack.emplace_back(0u, squared_distance_to_box(nodes_[0], P));
+		while (!stack.empty())
+		{
+			const auto [node, d2] = stack.back();
+			stack.pop_back();
+			if (d2 > best_d2)
+				continue;
+			const Node& n = nodes_[node];
+			if (n.nb_faces > 0u)
+			{
+				for (uint32 f = n.index, end = n.index + n.nb_faces; f < end; ++f)
+				{
+					Vec3 Q;
+					const Scalar fd2 = squared_distance_to_face(f, P, Q);
+					if (fd2 <= best_d2)
+					{
+						best_d2 = fd2;
+						best_face = f;
+						closest = Q;
+					}
+				}
+			}
+			else
+			{
+				const Scalar d1 = squared_distance_to_box(nodes_[n.index], P);
+				const Scalar d2 = squared_distance_to_box(nodes_[n.index + 1u], P);
+				// the nearest child is visited first
+				if (d1 <= d2)
+				{
+					stack.emplace_back(n.index + 1u, d2);
+					stack.emplace_back(n.index, d1);
+				}
+				else
+				{
+					stack.emplace_back(n.index, d1);
+					stack.emplace_back(n.index + 1u, d2);
+				}
+			}
+		}
+
+		if (best_face == INVALID_INDEX)
+			return false;
+		face = faces_[best_face];
+		return true;
+	}
+
+	/**
+	 * @brief apply f on the faces whose bounding box intersects the box [bb_min, bb_max]
+	 */
+	template <typename FUNC>
+	void foreach_face_in_box(const Vec3& bb_min, const Vec3& bb_max, const FUNC& f) const
+	{
+		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function parameter type");
+		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+		auto overlaps = [&](const Vec3f& min, const Vec3f& max) -> bool {
+			for (uint32 i = 0u; i < 3u; ++i)
+				if (Scalar(min[i]) > bb_max[i] || Scalar(max[i]) < bb_min[i])
+					return false;
+			return true;
+		};
+		foreach_face_in_nodes([&](const Node& n) { return overlaps(n.bb_min, n.bb_max); },
+							  [&](uint32 i) -> bool {
+								  const Box& b = face_boxes_[i];
+								  return overlaps(b.min, b.max) ? f(faces_[i]) : true;
+							  });
+	}
+
+	/**
+	 * @brief apply f on the faces that intersect the sphere of given center and radius
+	 */
+	template <typename FUNC>
+	void foreach_face_in_sphere(const Vec3& center, Scalar radius, const FUNC& f) const
+	{
+		static_assert(is_func_parameter_same<FUNC, Face>::value, "Wrong function parameter type");
+		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+		const Scalar r2 = radius * radius;
+		foreach_face_in_nodes([&](const Node& n) { return squared_distance_to_box(n, center) <= r2; },
+							  [&](uint32 i) -> bool {
+								  Vec3 Q;
+								  return squared_distance_to_face(i, center, Q) <= r2 ? f(faces_[i]) : true;
+							  });
+	}
+};
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_TYPES_BVH_H_
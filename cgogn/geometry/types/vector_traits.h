@@ -102,6 +102,11 @@ using Mat4 = Eigen::Matrix3d;
 
 using Scalar = vector_traits<Vec3>::Scalar;
 
+// float64 vector of the size of VEC: large sums of float32 values (e.g. over all the vertices of a mesh)
+// are accumulated in float64
+template <typename VEC>
+using AccumulationVec = Eigen::Matrix<double, int(vector_traits<VEC>::SIZE), 1>;
+
 } // namespace geometry
 
 } // namespace cgogn
@@ -0,0 +1,464 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#include <cgogn/io/cgb.h>
+#include <cgogn/io/mapped_file.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+namespace
+{
+
+using AttributeContainer = CMapBase::AttributeContainer;
+template <typename T>
+using Attribute = CMapBase::Attribute<T>;
+
+// the type tag of an attribute is the index of its value type in this tuple (new types must be appended)
+using CGBTypes = std::tuple<bool, int8, uint8, int32, uint32, int64, uint64, float32, float64, Dart, geometry::Vec2,
+							geometry::Vec3, geometry::Vec4, geometry::Vec2f, geometry::Vec3f, geometry::Vec4f,
+							geometry::Vec2i, geometry::Vec3i, geometry::Vec4i>;
+
+const char CGB_MAGIC[8] = {'C', 'G', 'O', 'G', 'N', 'C', 'G', 'B'};
+const uint32 CGB_VERSION = 2u;
+const uint64 CGB_PAGE_SIZE = 4096u;
+const uint32 CHUNK_SIZE = Attribute<uint32>::CHUNK_SIZE;
+
+// orbit containers are identified by their orbit, the darts container comes after them
+const uint32 DARTS_CONTAINER = NB_ORBITS;
+
+const std::string REF_COUNTER_NAME = "__refs";
+const std::string BOUNDARY_MARKER_NAME = "__boundary";
+// the boundary marker is stored as a uint64 attribute: one bit per dart, dart i is bit i % 64 of word i / 64
+using MarkAttribute = CMapBase::MarkAttribute;
+const uint32 MARK_CHUNK_NB_WORDS = MarkAttribute::CHUNK_NB_WORDS;
+
+struct FileHeader
+{
+	char magic[8];
+	uint32 version;
+	uint32 chunk_size;
+	uint32 nb_relations;
+	uint32 nb_containers;
+	uint32 nb_attributes;
+	uint32 names_size;
+};
+
+struct ContainerRecord
+{
+	uint32 id;
+	uint32 maximum_index;
+	uint32 nb_available_indices;
+	uint32 unused;
+	uint64 available_indices_offset;
+};
+
+struct AttributeRecord
+{
+	uint32 container_id;
+	uint32 type_tag;
+	uint32 element_size;
+	uint32 nb_chunks;
+	uint64 data_offset;
+	uint32 name_offset;
+	uint32 name_length;
+};
+
+inline uint64 align(uint64 offset, uint64 alignment)
+{
+	return (offset + alignment - 1u) / alignment * alignment;
+}
+
+template <typename T, std::size_t... Is>
+constexpr uint32 type_tag(std::index_sequence<Is...>)
+{
+	return uint32(((std::is_same_v<T, std::tuple_element_t<Is, CGBTypes>> ? Is : 0u) + ...));
+}
+
+template <typename T>
+constexpr uint32 type_tag()
+{
+	return type_tag<T>(std::make_index_sequence<std::tuple_size_v<CGBTypes>>{});
+}
+
+// calls f with a null pointer to the type of the given tag, returns false if the tag is unknown
+template <typename FUNC, std::size_t... Is>
+bool dispatch_type_tag(uint32 tag, const FUNC& f, std::index_sequence<Is...>)
+{
+	return ((tag == Is ? (f(static_cast<std::tuple_element_t<Is, CGBTypes>*>(nullptr)), true) : false) || ...);
+}
+
+template <typename FUNC>
+bool dispatch_type_tag(uint32 tag, const FUNC& f)
+{
+	return dispatch_type_tag(tag, f, std::make_index_sequence<std::tuple_size_v<CGBTypes>>{});
+}
+
+inline AttributeContainer& container(CMapBase& m, uint32 id)
+{
+	return id == DARTS_CONTAINER ? m.darts_ : m.attribute_containers_[id];
+}
+
+inline const AttributeContainer& container(const CMapBase& m, uint32 id)
+{
+	return id == DARTS_CONTAINER ? m.darts_ : m.attribute_containers_[id];
+}
+
+struct ExportData
+{
+	std::vector<ContainerRecord> containers_;
+	std::vector<AttributeRecord> attributes_;
+	std::vector<std::vector<const void*>> chunks_;
+	std::vector<uint64> mark_words_;
+	std::string names_;
+
+	template <typename T>
+	void add_attribute(uint32 container_id, const std::string& name, const Attribute<T>* attribute)
+	{
+		std::vector<const void*> chunks = attribute->chunk_pointers();
+		const uint32 nb_chunks = (containers_.back().maximum_index + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		if (uint32(chunks.size()) > nb_chunks)
+			chunks.resize(nb_chunks);
+		attributes_.push_back({container_id, type_tag<T>(), uint32(sizeof(T)), uint32(chunks.size()), 0u,
+							   uint32(names_.size()), uint32(name.size())});
+		chunks_.push_back(std::move(chunks));
+		names_ += name;
+	}
+
+	// packs the bits of the mark attribute in mark_words_ (only one mark attribute can be added)
+	void add_mark_attribute(uint32 container_id, const std::string& name, const MarkAttribute* attribute)
+	{
+		const uint32 nb_words = (containers_.back().maximum_index + 63u) / 64u;
+		const uint32 nb_chunks = (nb_words + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		const uint32 nb_mark_chunks =
+			std::min(attribute->nb_chunks(), (nb_words + MARK_CHUNK_NB_WORDS - 1u) / MARK_CHUNK_NB_WORDS);
+		mark_words_.assign(std::size_t(nb_chunks) * CHUNK_SIZE, 0u);
+		for (uint32 i = 0u; i < nb_mark_chunks; ++i)
+		{
+			const uint64* words = attribute->chunk_words(i);
+			std::copy(words, words + MARK_CHUNK_NB_WORDS, mark_words_.begin() + i * MARK_CHUNK_NB_WORDS);
+		}
+		std::vector<const void*> chunks(nb_chunks);
+		for (uint32 i = 0u; i < nb_chunks; ++i)
+			chunks[i] = mark_words_.data() + std::size_t(i) * CHUNK_SIZE;
+		attributes_.push_back({container_id, type_tag<uint64>(), uint32(sizeof(uint64)), nb_chunks, 0u,
+							   uint32(names_.size()), uint32(name.size())});
+		chunks_.push_back(std::move(chunks));
+		names_ += name;
+	}
+
+	template <typename T>
+	bool try_add_attribute(uint32 container_id, const AttributeGenT* ag)
+	{
+		if (!ag->is_of_type<T>())
+			return false;
+		add_attribute(container_id, ag->name(), static_cast<const Attribute<T>*>(ag));
+		return true;
+	}
+
+	template <std::size_t... Is>
+	bool try_add_attribute(uint32 container_id, const AttributeGenT* ag, std::index_sequence<Is...>)
+	{
+		return (try_add_attribute<std::tuple_element_t<Is, CGBTypes>>(container_id, ag) || ...);
+	}
+};
+
+class PaddedWriter
+{
+	std::ofstream& out_;
+	uint64 position_;
+
+public:
+	PaddedWriter(std::ofstream& out) : out_(out), position_(0u)
+	{
+	}
+
+	inline void write(const void* data, uint64 size)
+	{
+		out_.write(static_cast<const char*>(data), std::streamsize(size));
+		position_ += size;
+	}
+
+	inline void pad_to(uint64 position)
+	{
+		static const char zeros[CGB_PAGE_SIZE] = {};
+		while (position_ < position)
+			write(zeros, std::min(position - position_, CGB_PAGE_SIZE));
+	}
+};
+
+} // namespace
+
+bool export_CGB(const CMapBase& m, const std::string& filename)
+{
+	ExportData exp;
+
+	for (uint32 id = 0u; id <= DARTS_CONTAINER; ++id)
+	{
+		const AttributeContainer& c = container(m, id);
+		if (id != DARTS_CONTAINER && c.maximum_index() == 0u)
+			continue;
+
+		exp.containers_.push_back({id, c.maximum_index(), uint32(c.available_indices().size()), 0u, 0u});
+		exp.add_attribute(id, REF_COUNTER_NAME, c.ref_counter_.get());
+		if (id == DARTS_CONTAINER)
+			exp.add_mark_attribute(id, BOUNDARY_MARKER_NAME, m.boundary_marker_);
+
+		for (const std::shared_ptr<AttributeGenT>& ag : c)
+		{
+			if (!exp.try_add_attribute(id, ag.get(), std::make_index_sequence<std::tuple_size_v<CGBTypes>>{}))
+				std::cerr << "export_CGB: attribute \"" << ag->name() << "\" has an unsupported type and is not exported"
+						  << std::endl;
+		}
+	}
+
+	// layout: header, records, names, then the free indices lists and the page aligned attributes data
+	uint64 offset = sizeof(FileHeader) + exp.containers_.size() * sizeof(ContainerRecord) +
+					exp.attributes_.size() * sizeof(AttributeRecord) + exp.names_.size();
+	for (ContainerRecord& cr : exp.containers_)
+	{
+		offset = align(offset, sizeof(uint64));
+		cr.available_indices_offset = offset;
+		offset += uint64(cr.nb_available_indices) * sizeof(uint32);
+	}
+	for (AttributeRecord& ar : exp.attributes_)
+	{
+		offset = align(offset, CGB_PAGE_SIZE);
+		ar.data_offset = offset;
+		offset += uint64(ar.nb_chunks) * CHUNK_SIZE * ar.element_size;
+	}
+
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	if (!out.good())
+	{
+		std::cerr << "Unable to open file \"" << filename << "\"." << std::endl;
+		return false;
+	}
+
+	FileHeader header;
+	std::memcpy(header.magic, CGB_MAGIC, sizeof(CGB_MAGIC));
+	header.version = CGB_VERSION;
+	header.chunk_size = CHUNK_SIZE;
+	header.nb_relations = uint32(m.relations_.size());
+	header.nb_containers = uint32(exp.containers_.size());
+	header.nb_attributes = uint32(exp.attributes_.size());
+	header.names_size = uint32(exp.names_.size());
+
+	PaddedWriter writer(out);
+	writer.write(&header, sizeof(FileHeader));
+	writer.write(exp.containers_.data(), exp.containers_.size() * sizeof(ContainerRecord));
+	writer.write(exp.attributes_.data(), exp.attributes_.size() * sizeof(AttributeRecord));
+	writer.write(exp.names_.data(), exp.names_.size());
+
+	for (const ContainerRecord& cr : exp.containers_)
+	{
+		writer.pad_to(cr.available_indices_offset);
+		writer.write(container(m, cr.id).available_indices().data(),
+					 uint64(cr.nb_available_indices) * sizeof(uint32));
+	}
+	for (uint32 i = 0u, end = uint32(exp.attributes_.size()); i < end; ++i)
+	{
+		const AttributeRecord& ar = exp.attributes_[i];
+		writer.pad_to(ar.data_offset);
+		for (const void* chunk : exp.chunks_[i])
+			writer.write(chunk, uint64(CHUNK_SIZE) * ar.element_size);
+	}
+
+	if (!out.good())
+	{
+		std::cerr << "Error while writing file \"" << filename << "\"." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool import_CGB(CMapBase& m, const std::string& filename)
+{
+	if (m.darts_.maximum_index() != 0u)
+	{
+		std::cerr << "import_CGB: the map should be empty." << std::endl;
+		return false;
+	}
+
+	std::shared_ptr<MappedFile> file = MappedFile::open(filename);
+	if (!file)
+	{
+		std::cerr << "Unable to map file \"" << filename << "\"." << std::endl;
+		return false;
+	}
+	char* data = file->data();
+	const uint64 size = file->size();
+
+	FileHeader header;
+	if (size < sizeof(FileHeader) || (std::memcpy(&header, data, sizeof(FileHeader)),
+									  std::memcmp(header.magic, CGB_MAGIC, sizeof(CGB_MAGIC)) != 0))
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid cgb file." << std::endl;
+		return false;
+	}
+	if (header.version != CGB_VERSION || header.chunk_size != CHUNK_SIZE)
+	{
+		std::cerr << "File \"" << filename << "\" was written by an incompatible version." << std::endl;
+		return false;
+	}
+	if (header.nb_relations != uint32(m.relations_.size()))
+	{
+		std::cerr << "File \"" << filename << "\" does not contain a map of this type." << std::endl;
+		return false;
+	}
+
+	const uint64 records_size = sizeof(FileHeader) + uint64(header.nb_containers) * sizeof(ContainerRecord) +
+								uint64(header.nb_attributes) * sizeof(AttributeRecord) + header.names_size;
+	if (records_size > size)
+	{
+		std::cerr << "File \"" << filename << "\" is truncated." << std::endl;
+		return false;
+	}
+
+	std::vector<ContainerRecord> containers(header.nb_containers);
+	std::vector<AttributeRecord> attributes(header.nb_attributes);
+	const char* p = data + sizeof(FileHeader);
+	std::memcpy(containers.data(), p, containers.size() * sizeof(ContainerRecord));
+	p += containers.size() * sizeof(ContainerRecord);
+	std::memcpy(attributes.data(), p, attributes.size() * sizeof(AttributeRecord));
+	p += attributes.size() * sizeof(AttributeRecord);
+	const std::string names(p, header.names_size);
+
+	// check all records before modifying the map
+	bool valid = std::any_of(containers.begin(), containers.end(),
+							 [](const ContainerRecord& cr) { return cr.id == DARTS_CONTAINER; });
+	for (const ContainerRecord& cr : containers)
+	{
+		valid &= cr.id <= DARTS_CONTAINER && cr.nb_available_indices <= cr.maximum_index &&
+				 cr.available_indices_offset + uint64(cr.nb_available_indices) * sizeof(uint32) <= size;
+	}
+	for (const AttributeRecord& ar : attributes)
+	{
+		uint32 element_size = 0u;
+		valid &= dispatch_type_tag(ar.type_tag, [&](auto* t) { element_size = uint32(sizeof(*t)); });
+		valid &= ar.container_id <= DARTS_CONTAINER && ar.element_size == element_size &&
+				 uint64(ar.name_offset) + ar.name_length <= names.size() && ar.data_offset % CGB_PAGE_SIZE == 0u &&
+				 ar.data_offset + uint64(ar.nb_chunks) * CHUNK_SIZE * ar.element_size <= size;
+	}
+	for (const auto& relation : m.relations_)
+	{
+		valid &= std::any_of(attributes.begin(), attributes.end(), [&](const AttributeRecord& ar) {
+			return ar.container_id == DARTS_CONTAINER && ar.type_tag == type_tag<Dart>() &&
+				   names.compare(ar.name_offset, ar.name_length, relation->name()) == 0;
+		});
+	}
+	if (!valid)
+	{
+		std::cerr << "File \"" << filename << "\" is corrupted or does not contain a map of this type." << std::endl;
+		return false;
+	}
+
+	// make the attributes chunks point into the mapped file
+	const AttributeRecord* boundary_record = nullptr;
+	for (const AttributeRecord& ar : attributes)
+	{
+		AttributeContainer& c = container(m, ar.container_id);
+		const std::string name = names.substr(ar.name_offset, ar.name_length);
+		if (ar.container_id == DARTS_CONTAINER && ar.type_tag == type_tag<uint64>() && name == BOUNDARY_MARKER_NAME)
+		{
+			// the bits are copied once the darts indices are restored
+			boundary_record = &ar;
+			continue;
+		}
+		dispatch_type_tag(ar.type_tag, [&](auto* t) {
+			using T = std::remove_pointer_t<decltype(t)>;
+			Attribute<T>* attribute = nullptr;
+			if constexpr (std::is_same_v<T, uint32>)
+			{
+				if (name == REF_COUNTER_NAME)
+					attribute = c.ref_counter_.get();
+			}
+			if (!attribute)
+			{
+				std::shared_ptr<Attribute<T>> a = c.get_attribute<T>(name);
+				if (!a)
+					a = c.add_attribute<T>(name);
+				attribute = a.get();
+			}
+			if (!attribute)
+			{
+				std::cerr << "import_CGB: attribute \"" << name << "\" cannot be created." << std::endl;
+				return;
+			}
+			std::vector<T*> chunks(ar.nb_chunks);
+			for (uint32 i = 0u; i < ar.nb_chunks; ++i)
+				chunks[i] = reinterpret_cast<T*>(data + ar.data_offset + uint64(i) * CHUNK_SIZE * sizeof(T));
+			attribute->adopt_chunks(chunks, file);
+		});
+	}
+
+	for (const ContainerRecord& cr : containers)
+	{
+		std::vector<uint32> available_indices(cr.nb_available_indices);
+		std::memcpy(available_indices.data(), data + cr.available_indices_offset,
+					available_indices.size() * sizeof(uint32));
+		container(m, cr.id).restore_indices(cr.maximum_index, available_indices);
+	}
+
+	if (boundary_record)
+	{
+		const uint64* words = reinterpret_cast<const uint64*>(data + boundary_record->data_offset);
+		const uint64 nb_words = uint64(boundary_record->nb_chunks) * CHUNK_SIZE;
+		for (uint32 i = 0u, end = m.boundary_marker_->nb_chunks(); i < end; ++i)
+		{
+			if (uint64(i + 1u) * MARK_CHUNK_NB_WORDS > nb_words)
+				break;
+			std::copy(words + uint64(i) * MARK_CHUNK_NB_WORDS, words + uint64(i + 1u) * MARK_CHUNK_NB_WORDS,
+					  m.boundary_marker_->chunk_words(i));
+		}
+	}
+
+	for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+	{
+		std::ostringstream oss;
+		oss << "__index_" << orbit_name(Orbit(orbit));
+		m.cells_indices_[orbit] = m.darts_.get_attribute<uint32>(oss.str());
+	}
+	m.invalidate_nb_cells();
+
+	return true;
+}
+
+} // namespace io
+
+} // namespace cgogn
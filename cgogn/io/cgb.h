@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_IO_CGB_H_
+#define CGOGN_IO_CGB_H_
+
+#include <cgogn/io/cgogn_io_export.h>
+
+#include <cgogn/core/types/cmap/cmap_base.h>
+
+#include <string>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+/**
+ * CGoGN binary map format (.cgb)
+ *
+ * The file is a raw dump of the containers of a map: the darts container (relations, cells indices,
+ * boundary marker, user dart attributes) and each non empty orbit container, with their reference counters,
+ * free indices lists and all their attributes of a supported type (scalars, Dart, fixed size Eigen vectors).
+ * Attributes values are stored chunk by chunk (ChunkArray::CHUNK_SIZE elements per chunk) and the data of each
+ * attribute starts on a page boundary, so that the chunks of the loaded attributes point directly into the
+ * memory mapped file: loading costs page faults instead of parsing and topology reconstruction.
+ * The boundary marker (one bit per dart) is the only attribute that is copied at loading.
+ * Values are stored in the byte order of the writing machine.
+ * The map level attributes (CMapBase::attributes_) are not stored.
+ */
+
+// the map must be of the same type (same relations) as the exported one and must be empty
+bool CGOGN_IO_EXPORT import_CGB(CMapBase& m, const std::string& filename);
+
+bool CGOGN_IO_EXPORT export_CGB(const CMapBase& m, const std::string& filename);
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_CGB_H_
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/types/cmap/cmap3.h>
+#include <cgogn/core/utils/thread.h>
+
+#include <cgogn/io/mapped_file.h>
+#include <cgogn/io/surface/obj.h>
+#include <cgogn/io/surface/off.h>
+#include <cgogn/io/text_parser.h>
+#include <cgogn/io/utils.h>
+#include <cgogn/io/volume/tet.h>
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#define DEFAULT_MESH_PATH CGOGN_STR(CGOGN_DATA_PATH) "/meshes/"
+
+using namespace cgogn;
+
+// best wall-clock time (in seconds) of nb_runs calls of f
+template <typename FUNC>
+float64 best_time(uint32 nb_runs, const FUNC& f)
+{
+	float64 best = std::numeric_limits<float64>::max();
+	for (uint32 i = 0; i < nb_runs; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<float64> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+// number of numbers of a text file read token by token from a stream with std::stod (former parsing method)
+uint64 count_numbers_stream(const std::string& filename)
+{
+	io::Scoped_C_Locale loc;
+	std::ifstream fp(filename.c_str(), std::ios::in);
+	std::string token;
+	uint64 nb = 0u;
+	while (fp >> token)
+	{
+		if (token[0] == '#')
+			fp.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+		else if (std::isdigit(token[0]) || token[0] == '-' || token[0] == '+' || token[0] == '.')
+		{
+			std::stod(token);
+			++nb;
+		}
+	}
+	return nb;
+}
+
+// number of numbers of a text file read from a mapped file in parallel with std::from_chars (parsing backend)
+uint64 count_numbers_mapped(const std::string& filename)
+{
+	std::shared_ptr<io::MappedFile> file = io::MappedFile::open(filename);
+	if (!file)
+		return 0u;
+	const std::vector<const char*> bounds = io::split_lines(file->data(), file->data() + file->size(),
+															io::nb_text_chunks(file->size()));
+	std::atomic<uint64> nb = 0u;
+	io::parallel_foreach_text_chunk(bounds, [&](uint32, io::TextTokenizer& t) {
+		uint64 chunk_nb = 0u;
+		for (t.skip_whitespaces(); !t.at_end(); t.skip_whitespaces())
+		{
+			float64 number;
+			if (t.read(number))
+				++chunk_nb;
+			else
+				t.skip_word();
+		}
+		nb += chunk_nb;
+	});
+	return nb;
+}
+
+// throughput of the token reading methods and of the import of the given file
+bool bench_file(const std::string& filename)
+{
+	const std::string extension = filename.substr(filename.find_last_of('.') + 1u);
+
+	std::function<bool()> import;
+	if (extension == "off")
+		import = [&]() {
+			CMap2 m;
+			return io::import_OFF(m, filename);
+		};
+	else if (extension == "obj")
+		import = [&]() {
+			CMap2 m;
+			return io::import_OBJ(m, filename);
+		};
+	else if (extension == "tet")
+		import = [&]() {
+			CMap3 m;
+			return io::import_TET(m, filename);
+		};
+	else
+	{
+		std::cout << filename << ": unsupported file format" << std::endl;
+		return false;
+	}
+
+	std::shared_ptr<io::MappedFile> file = io::MappedFile::open(filename);
+	if (!file)
+	{
+		std::cout << "could not open " << filename << std::endl;
+		return false;
+	}
+	const float64 size = float64(file->size()) / 1e6;
+	file.reset();
+
+	uint64 nb_numbers_stream = 0u;
+	float64 stream_time = best_time(3, [&]() { nb_numbers_stream = count_numbers_stream(filename); });
+	uint64 nb_numbers_mapped = 0u;
+	float64 mapped_time = best_time(3, [&]() { nb_numbers_mapped = count_numbers_mapped(filename); });
+	bool imported = true;
+	float64 import_time = best_time(3, [&]() { imported &= import(); });
+
+	std::cout << filename << ": " << std::fixed << std::setprecision(1) << size << " MB, " << nb_numbers_mapped
+			  << " numbers, best of 3" << std::endl;
+	std::cout << "  stream tokens (std::stod):       " << size / stream_time << " MB/s"
+			  << (nb_numbers_stream == nb_numbers_mapped ? "" : " (number count mismatch)") << std::endl;
+	std::cout << "  mapped chunks (std::from_chars): " << size / mapped_time << " MB/s" << std::endl;
+	std::cout << "  import (with the map building):  " << std::setprecision(3) << import_time << " s, "
+			  << std::setprecision(1) << size / import_time << " MB/s" << (imported ? "" : " (failed)") << std::endl;
+
+	return imported;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> filenames(argv + 1, argv + argc);
+	if (filenames.empty())
+	{
+		std::cout << "Usage: " << argv[0] << " mesh_file.{off,obj,tet}..." << std::endl;
+		filenames = {std::string(DEFAULT_MESH_PATH) + "off/horse.off", std::string(DEFAULT_MESH_PATH) + "tet/hand.tet"};
+	}
+
+	thread_start();
+
+	bool ok = true;
+	for (const std::string& filename : filenames)
+		ok &= bench_file(filename);
+
+	return ok ? 0 : 1;
+}
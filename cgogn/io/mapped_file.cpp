@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#include <cgogn/io/mapped_file.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cgogn
+{
+
+namespace io
+{
+
+MappedFile::MappedFile(char* data, std::size_t size) : data_(data), size_(size)
+{
+}
+
+#ifdef _WIN32
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& filename)
+{
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							  FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+		return nullptr;
+
+	// the view keeps a reference on the mapping object
+	void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr)
+		return nullptr;
+
+	return std::shared_ptr<MappedFile>(new MappedFile(static_cast<char*>(data), std::size_t(size.QuadPart)));
+}
+
+MappedFile::~MappedFile()
+{
+	UnmapViewOfFile(data_);
+}
+
+#else
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& filename)
+{
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		::close(fd);
+		return nullptr;
+	}
+
+	// the mapping stays valid after the file descriptor is closed
+	void* data = mmap(nullptr, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	return std::shared_ptr<MappedFile>(new MappedFile(static_cast<char*>(data), std::size_t(st.st_size)));
+}
+
+MappedFile::~MappedFile()
+{
+	munmap(data_, size_);
+}
+
+#endif
+
+} // namespace io
+
+} // namespace cgogn
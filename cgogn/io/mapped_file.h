@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_IO_MAPPED_FILE_H_
+#define CGOGN_IO_MAPPED_FILE_H_
+
+#include <cgogn/io/cgogn_io_export.h>
+
+#include <cgogn/core/utils/numerics.h>
+
+#include <memory>
+#include <string>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+/**
+ * @brief read-only file mapped in memory
+ * The mapping is copy-on-write: its content can be modified in memory, the modifications are private
+ * and never written back to the file. Pages are loaded on first access.
+ */
+class CGOGN_IO_EXPORT MappedFile
+{
+public:
+	// returns nullptr if the file cannot be mapped
+	static std::shared_ptr<MappedFile> open(const std::string& filename);
+
+	~MappedFile();
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(MappedFile);
+
+	inline char* data() const
+	{
+		return data_;
+	}
+
+	inline std::size_t size() const
+	{
+		return size_;
+	}
+
+private:
+	MappedFile(char* data, std::size_t size);
+
+	char* data_;
+	std::size_t size_;
+};
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_MAPPED_FILE_H_
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_IO_SURFACE_OBJ_H_
+#define CGOGN_IO_SURFACE_OBJ_H_
+
+#include <cgogn/io/mapped_file.h>
+#include <cgogn/io/surface/surface_import.h>
+#include <cgogn/io/text_parser.h>
+
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/utils/numerics.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <atomic>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+/**
+ * @brief import the vertices ("v") and faces ("f") of an OBJ file
+ * Face corners may be given as v, v/vt, v//vn or v/vt/vn, with positive (1-based) or negative (relative) indices.
+ * Other elements (texture coordinates, normals, groups, materials, ...) are ignored.
+ * The file is mapped in memory and split into chunks of lines that are parsed in parallel.
+ */
+template <typename MESH>
+bool import_OBJ(MESH& m, const std::string& filename)
+{
+	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
+
+	using Vertex = typename MESH::Vertex;
+
+	std::shared_ptr<MappedFile> file = MappedFile::open(filename);
+	if (!file)
+	{
+		std::cerr << "Unable to open file \"" << filename << "\"." << std::endl;
+		return false;
+	}
+
+	const std::vector<const char*> bounds =
+		split_lines(file->data(), file->data() + file->size(), nb_text_chunks(file->size()));
+	const uint32 nb_chunks = uint32(bounds.size()) - 1u;
+
+	// count the vertices of each chunk: the vertices are numbered in the order of the file
+	std::vector<uint32> vertices_ranks(nb_chunks + 1u, 0u);
+	parallel_foreach_text_chunk(bounds, [&](uint32 chunk, TextTokenizer& t) {
+		uint32 nb = 0u;
+		for (; !t.at_end(); t.next_line())
+		{
+			if (t.keyword("v"))
+				++nb;
+		}
+		vertices_ranks[chunk + 1u] = nb;
+	});
+	for (uint32 i = 0u; i < nb_chunks; ++i)
+		vertices_ranks[i + 1u] += vertices_ranks[i];
+	const uint32 nb_vertices = vertices_ranks.back();
+
+	if (nb_vertices == 0u)
+	{
+		std::cerr << "File \"" << filename << " has no vertices." << std::endl;
+		return false;
+	}
+
+	SurfaceImportData surface_data;
+	surface_data.vertices_id_.reserve(nb_vertices);
+	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
+
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+		surface_data.vertices_id_.push_back(new_index<Vertex>(m));
+
+	std::vector<std::vector<uint32>> faces_nb_vertices(nb_chunks);
+	std::vector<std::vector<uint32>> faces_vertex_indices(nb_chunks);
+	std::atomic<bool> valid = true;
+
+	parallel_foreach_text_chunk(bounds, [&](uint32 chunk, TextTokenizer& t) {
+		std::vector<uint32>& chunk_faces_nb_vertices = faces_nb_vertices[chunk];
+		std::vector<uint32>& chunk_faces_vertex_indices = faces_vertex_indices[chunk];
+		// number of vertices defined before the current line
+		uint32 nb_defined_vertices = vertices_ranks[chunk];
+		for (; !t.at_end(); t.next_line())
+		{
+			if (t.keyword("v"))
+			{
+				float64 x = 0.0, y = 0.0, z = 0.0;
+				if (!t.read(x) || !t.read(y) || !t.read(z))
+					valid = false;
+				(*position)[surface_data.vertices_id_[nb_defined_vertices++]] = {x, y, z};
+			}
+			else if (t.keyword("f"))
+			{
+				uint32 n = 0u;
+				while (!t.end_of_line())
+				{
+					int64 index = 0;
+					if (!t.read(index))
+					{
+						valid = false;
+						break;
+					}
+					t.skip_word(); // texture coordinates and normal indices
+					index = index > 0 ? index - 1 : (index < 0 ? int64(nb_defined_vertices) + index : -1);
+					if (index < 0 || index >= int64(nb_vertices))
+					{
+						valid = false;
+						index = 0;
+					}
+					chunk_faces_vertex_indices.push_back(surface_data.vertices_id_[uint32(index)]);
+					++n;
+				}
+				chunk_faces_nb_vertices.push_back(n);
+			}
+		}
+	});
+
+	if (!valid)
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid obj file." << std::endl;
+		return false;
+	}
+
+	parallel_concatenate(faces_nb_vertices, surface_data.faces_nb_vertices_);
+	parallel_concatenate(faces_vertex_indices, surface_data.faces_vertex_indices_);
+
+	import_surface_data(m, surface_data);
+
+	return true;
+}
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_SURFACE_OBJ_H_
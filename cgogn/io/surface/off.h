@@ -24,8 +24,9 @@
 #ifndef CGOGN_IO_SURFACE_OFF_H_
 #define CGOGN_IO_SURFACE_OFF_H_
 
+#include <cgogn/io/mapped_file.h>
 #include <cgogn/io/surface/surface_import.h>
-#include <cgogn/io/utils.h>
+#include <cgogn/io/text_parser.h>
 
 #include <cgogn/core/functions/attributes.h>
 #include <cgogn/core/functions/mesh_info.h>
@@ -34,6 +35,7 @@
 
 #include <cgogn/geometry/types/vector_traits.h>
 
+#include <atomic>
 #include <fstream>
 #include <vector>
 
@@ -43,6 +45,10 @@ namespace cgogn
 namespace io
 {
 
+/**
+ * @brief import an OFF file (one vertex or face per line)
+ * The file is mapped in memory and split into chunks of lines that are parsed in parallel.
+ */
 template <typename MESH>
 bool import_OFF(MESH& m, const std::string& filename)
 {
@@ -50,27 +56,34 @@ bool import_OFF(MESH& m, const std::string& filename)
 
 	using Vertex = typename MESH::Vertex;
 
-	Scoped_C_Locale loc;
-
-	SurfaceImportData surface_data;
-
-	std::ifstream fp(filename.c_str(), std::ios::in);
+	std::shared_ptr<MappedFile> file = MappedFile::open(filename);
+	if (!file)
+	{
+		std::cerr << "Unable to open file \"" << filename << "\"." << std::endl;
+		return false;
+	}
 
-	std::string line;
-	line.reserve(512u);
+	TextTokenizer header(file->data(), file->data() + file->size());
 
 	// read OFF header
-	getline_safe(fp, line);
-	if (line.rfind("OFF") == std::string::npos)
+	header.skip_whitespaces();
+	const char* first_line = header.position();
+	header.next_line();
+	if (std::string(first_line, header.position()).rfind("OFF") == std::string::npos)
 	{
 		std::cerr << "File \"" << filename << "\" is not a valid off file." << std::endl;
 		return false;
 	}
 
-	// read number of vertices, edges, faces
-	const uint32 nb_vertices = read_uint(fp, line);
-	const uint32 nb_faces = read_uint(fp, line);
-	/*const uint32 nb_edges_ =*/read_uint(fp, line);
+	// read number of vertices, faces, edges
+	uint32 nb_vertices = 0u, nb_faces = 0u;
+	header.skip_whitespaces();
+	if (!header.read(nb_vertices) || !header.read(nb_faces))
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid off file." << std::endl;
+		return false;
+	}
+	header.next_line();
 
 	if (nb_vertices == 0u)
 	{
@@ -78,36 +91,73 @@ bool import_OFF(MESH& m, const std::string& filename)
 		return false;
 	}
 
+	SurfaceImportData surface_data;
 	surface_data.reserve(nb_vertices, nb_faces);
 	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
 
-	// read vertices position
 	for (uint32 i = 0u; i < nb_vertices; ++i)
-	{
-		float64 x = read_double(fp, line);
-		float64 y = read_double(fp, line);
-		float64 z = read_double(fp, line);
-
-		uint32 vertex_id = new_index<Vertex>(m);
-		(*position)[vertex_id] = {x, y, z};
-
-		surface_data.vertices_id_.push_back(vertex_id);
-	}
+		surface_data.vertices_id_.push_back(new_index<Vertex>(m));
 
-	// read faces (vertex indices)
-	for (uint32 i = 0u; i < nb_faces; ++i)
+	const std::vector<const char*> bounds =
+		split_lines(header.position(), file->data() + file->size(), nb_text_chunks(file->size()));
+	const std::vector<uint32> ranks = data_lines_ranks(bounds);
+	if (ranks.back() < nb_vertices + nb_faces)
 	{
-		uint32 n = read_uint(fp, line);
+		std::cerr << "File \"" << filename << "\" is truncated." << std::endl;
+		return false;
+	}
 
-		std::vector<uint32> indices(n);
-		for (uint32 j = 0u; j < n; ++j)
-			indices[j] = surface_data.vertices_id_[read_uint(fp, line)];
+	const uint32 nb_chunks = uint32(bounds.size()) - 1u;
+	std::vector<std::vector<uint32>> faces_nb_vertices(nb_chunks);
+	std::vector<std::vector<uint32>> faces_vertex_indices(nb_chunks);
+	std::atomic<bool> valid = true;
+
+	parallel_foreach_text_chunk(bounds, [&](uint32 chunk, TextTokenizer& t) {
+		std::vector<uint32>& chunk_faces_nb_vertices = faces_nb_vertices[chunk];
+		std::vector<uint32>& chunk_faces_vertex_indices = faces_vertex_indices[chunk];
+		for (uint32 l = ranks[chunk]; !t.at_end() && l < nb_vertices + nb_faces; t.next_line())
+		{
+			if (!t.data_line())
+				continue;
+			if (l < nb_vertices)
+			{
+				// read vertex position
+				float64 x = 0.0, y = 0.0, z = 0.0;
+				if (!t.read(x) || !t.read(y) || !t.read(z))
+					valid = false;
+				(*position)[surface_data.vertices_id_[l]] = {x, y, z};
+			}
+			else
+			{
+				// read face (vertex indices)
+				uint32 n = 0u;
+				if (!t.read(n))
+					valid = false;
+				for (uint32 j = 0u; j < n; ++j)
+				{
+					uint32 index = 0u;
+					if (!t.read(index) || index >= nb_vertices)
+					{
+						valid = false;
+						index = 0u;
+					}
+					chunk_faces_vertex_indices.push_back(surface_data.vertices_id_[index]);
+				}
+				chunk_faces_nb_vertices.push_back(n);
+			}
+			++l;
+		}
+	});
 
-		surface_data.faces_nb_vertices_.push_back(n);
-		surface_data.faces_vertex_indices_.insert(surface_data.faces_vertex_indices_.end(), indices.begin(),
-												  indices.end());
+	if (!valid)
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid off file." << std::endl;
+		return false;
 	}
 
+	parallel_concatenate(faces_nb_vertices, surface_data.faces_nb_vertices_);
+	parallel_concatenate(faces_vertex_indices, surface_data.faces_vertex_indices_);
+
 	import_surface_data(m, surface_data);
 
 	return true;
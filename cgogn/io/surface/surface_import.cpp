@@ -28,7 +28,10 @@
 #include <cgogn/core/types/mesh_traits.h>
 
 #include <cgogn/core/types/cmap/cmap_ops.h>
+#include <cgogn/core/utils/work_stealing.h>
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 
 namespace cgogn
@@ -37,11 +40,122 @@ namespace cgogn
 namespace io
 {
 
+// darts of the created faces with the indices of their two vertices
+struct ImportHalfEdge
+{
+	Dart dart;
+	uint32 from;
+	uint32 to;
+};
+
+// sew the half-edges of the created faces and close the remaining holes
+template <typename MESH>
+static void sew_half_edges(MESH& m, const std::vector<ImportHalfEdge>& half_edges)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+
+	// sort the half-edges by the smallest index of their two vertices (counting sort)
+	// the order of the half-edges inside a bucket depends on the scheduling: buckets are sorted afterwards
+
+	const uint32 nb_half_edges = uint32(half_edges.size());
+	const uint32 nb_vertices = maximum_index<Vertex>(m);
+
+	std::vector<std::atomic<uint32>> bucket_positions(nb_vertices);
+	parallel_foreach_range(0u, nb_half_edges, [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+		{
+			const ImportHalfEdge& he = half_edges[i];
+			bucket_positions[std::min(he.from, he.to)].fetch_add(1u, std::memory_order_relaxed);
+		}
+	});
+
+	std::vector<uint32> buckets_offsets(nb_vertices + 1u);
+	buckets_offsets[0] = 0u;
+	for (uint32 v = 0u; v < nb_vertices; ++v)
+	{
+		buckets_offsets[v + 1u] = buckets_offsets[v] + bucket_positions[v].load(std::memory_order_relaxed);
+		bucket_positions[v].store(buckets_offsets[v], std::memory_order_relaxed);
+	}
+
+	std::vector<uint32> buckets(nb_half_edges);
+	parallel_foreach_range(0u, nb_half_edges, [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+		{
+			const ImportHalfEdge& he = half_edges[i];
+			buckets[bucket_positions[std::min(he.from, he.to)].fetch_add(1u, std::memory_order_relaxed)] = i;
+		}
+	});
+
+	// in each bucket, the half-edges of a same edge are consecutive once sorted by their other vertex
+	// the half-edges going from the smallest to the largest vertex are sewn to the ones going the other way,
+	// pairing them in the order of their creation (as they would be sewn sequentially)
+	// more than one half-edge in a direction means that the edge is non manifold: the remaining ones stay unsewn
+
+	std::atomic<uint32> nb_boundary_edges = 0u;
+	std::atomic<uint32> nb_non_manifold_edges = 0u;
+
+	parallel_foreach_range(0u, nb_vertices, [&](uint32 begin, uint32 end) {
+		std::vector<Dart> forward_darts;
+		std::vector<Dart> backward_darts;
+		uint32 nb_boundary = 0u;
+		uint32 nb_non_manifold = 0u;
+
+		for (uint32 v = begin; v < end; ++v)
+		{
+			auto first = buckets.begin() + buckets_offsets[v];
+			auto last = buckets.begin() + buckets_offsets[v + 1u];
+			auto other_vertex = [&](uint32 i) -> uint32 { return std::max(half_edges[i].from, half_edges[i].to); };
+			// half-edges indices follow the creation order of the darts
+			std::sort(first, last, [&](uint32 i, uint32 j) {
+				const uint32 oi = other_vertex(i);
+				const uint32 oj = other_vertex(j);
+				return oi < oj || (oi == oj && i < j);
+			});
+
+			while (first != last)
+			{
+				const uint32 w = other_vertex(*first);
+				forward_darts.clear();
+				backward_darts.clear();
+				for (; first != last && other_vertex(*first) == w; ++first)
+				{
+					const ImportHalfEdge& he = half_edges[*first];
+					if (he.from == v)
+						forward_darts.push_back(he.dart);
+					else
+						backward_darts.push_back(he.dart);
+				}
+
+				const uint32 nb_pairs = uint32(std::min(forward_darts.size(), backward_darts.size()));
+				for (uint32 i = 0u; i < nb_pairs; ++i)
+					phi2_sew(m, forward_darts[i], backward_darts[i]);
+				nb_boundary += uint32(forward_darts.size() + backward_darts.size()) - 2u * nb_pairs;
+				if (forward_darts.size() > 1u || backward_darts.size() > 1u)
+					++nb_non_manifold;
+			}
+		}
+
+		nb_boundary_edges += nb_boundary;
+		nb_non_manifold_edges += nb_non_manifold;
+	});
+
+	if (nb_non_manifold_edges > 0u)
+		std::cout << nb_non_manifold_edges << " non manifold edge(s) have been split" << std::endl;
+
+	if (nb_boundary_edges > 0u)
+	{
+		uint32 nb_holes = close(m);
+		std::cout << nb_holes << " hole(s) have been closed" << std::endl;
+		std::cout << nb_boundary_edges << " boundary edges" << std::endl;
+	}
+}
+
 void import_surface_data(CMap2& m, const SurfaceImportData& surface_data)
 {
 	using Vertex = CMap2::Vertex;
 
-	auto darts_per_vertex = add_attribute<std::vector<Dart>, Vertex>(m, "__darts_per_vertex");
+	std::vector<ImportHalfEdge> half_edges;
+	half_edges.reserve(surface_data.faces_vertex_indices_.size());
 
 	uint32 faces_vertex_index = 0u;
 	std::vector<uint32> vertices_buffer;
@@ -73,64 +187,65 @@ void import_surface_data(CMap2& m, const SurfaceImportData& surface_data)
 			Dart d = f.dart;
 			for (uint32 j = 0u; j < nbv; ++j)
 			{
-				const uint32 vertex_index = vertices_buffer[j];
-				set_index<Vertex>(m, d, vertex_index);
-				(*darts_per_vertex)[vertex_index].push_back(d);
+				set_index<Vertex>(m, d, vertices_buffer[j]);
+				half_edges.push_back({d, vertices_buffer[j], vertices_buffer[(j + 1u) % nbv]});
 				d = phi1(m, d);
 			}
 		}
 	}
 
-	bool need_vertex_unicity_check = false;
-	uint32 nb_boundary_edges = 0u;
+	sew_half_edges(m, half_edges);
+}
+
+void import_surface_data(TriMap2& m, const SurfaceImportData& surface_data)
+{
+	using Vertex = TriMap2::Vertex;
+
+	uint32 nb_half_edges = 0u;
+	for (uint32 nbv : surface_data.faces_nb_vertices_)
+		nb_half_edges += nbv > 2u ? 3u * (nbv - 2u) : 0u;
+	std::vector<ImportHalfEdge> half_edges;
+	half_edges.reserve(nb_half_edges);
+
+	uint32 faces_vertex_index = 0u;
+	std::vector<uint32> vertices_buffer;
+	vertices_buffer.reserve(16u);
 
-	for (Dart d = m.begin(), end = m.end(); d != end; d = m.next(d))
+	for (uint32 i = 0u, end = uint32(surface_data.faces_nb_vertices_.size()); i < end; ++i)
 	{
-		if (phi2(m, d) == d)
-		{
-			uint32 vertex_index = index_of(m, Vertex(d));
+		uint32 nbv = surface_data.faces_nb_vertices_[i];
 
-			const std::vector<Dart>& next_vertex_darts =
-				value<std::vector<Dart>>(m, darts_per_vertex, Vertex(phi1(m, d)));
-			bool phi2_found = false;
-			bool first_OK = true;
+		vertices_buffer.clear();
+		uint32 prev = std::numeric_limits<uint32>::max();
 
-			for (auto it = next_vertex_darts.begin(); it != next_vertex_darts.end() && !phi2_found; ++it)
+		for (uint32 j = 0u; j < nbv; ++j)
+		{
+			uint32 idx = surface_data.faces_vertex_indices_[faces_vertex_index++];
+			if (idx != prev)
 			{
-				if (index_of(m, Vertex(phi1(m, *it))) == vertex_index)
-				{
-					if (phi2(m, *it) == *it)
-					{
-						phi2_sew(m, d, *it);
-						phi2_found = true;
-					}
-					else
-						first_OK = false;
-				}
+				prev = idx;
+				vertices_buffer.push_back(idx);
 			}
-
-			if (!phi2_found)
-				++nb_boundary_edges;
-
-			if (!first_OK)
-				need_vertex_unicity_check = true;
 		}
-	}
+		if (vertices_buffer.front() == vertices_buffer.back())
+			vertices_buffer.pop_back();
 
-	if (nb_boundary_edges > 0u)
-	{
-		uint32 nb_holes = close(m);
-		std::cout << nb_holes << " hole(s) have been closed" << std::endl;
-		std::cout << nb_boundary_edges << " boundary edges" << std::endl;
+		// polygons are split into a fan of triangles around their first vertex
+		nbv = uint32(vertices_buffer.size());
+		for (uint32 j = 1u; j + 1u < nbv; ++j)
+		{
+			const uint32 triangle[3] = {vertices_buffer[0], vertices_buffer[j], vertices_buffer[j + 1u]};
+			Dart d = add_triangle_darts(m);
+			for (uint32 k = 0u; k < 3u; ++k)
+			{
+				Dart dk(d.index + k);
+				set_index<Vertex>(m, dk, triangle[k]);
+				half_edges.push_back({dk, triangle[k], triangle[(k + 1u) % 3u]});
+			}
+		}
 	}
 
-	// if (need_vertex_unicity_check)
-	// {
-	// 	map_.template enforce_unique_orbit_embedding<Vertex::ORBIT>();
-	// 	cgogn_log_warning("create_map") << "Import Surface: non manifold vertices detected and corrected";
-	// }
-
-	remove_attribute<Vertex>(m, darts_per_vertex);
+	sew_half_edges(m, half_edges);
 }
 
 } // namespace io
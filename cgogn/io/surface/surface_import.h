@@ -52,6 +52,9 @@ struct SurfaceImportData
 
 void CGOGN_IO_EXPORT import_surface_data(CMap2& m, const SurfaceImportData& surface_data);
 
+// the polygons are triangulated (fan around their first vertex)
+void CGOGN_IO_EXPORT import_surface_data(TriMap2& m, const SurfaceImportData& surface_data);
+
 } // namespace io
 
 } // namespace cgogn
@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * Copyright (C), IGG Group, ICube, University of Strasbourg, France            *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef CGOGN_IO_TEXT_PARSER_H_
+#define CGOGN_IO_TEXT_PARSER_H_
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/work_stealing.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+/**
+ * @brief reads numbers from a range of text (e.g. a part of a mapped file) without any allocation
+ * Blank lines and comment lines (starting with '#') are not data lines.
+ * Numbers are read with std::from_chars, which does not depend on the current locale.
+ */
+class TextTokenizer
+{
+	const char* cur_;
+	const char* end_;
+
+public:
+	inline TextTokenizer(const char* begin, const char* end) : cur_(begin), end_(end)
+	{
+	}
+
+	inline const char* position() const
+	{
+		return cur_;
+	}
+
+	inline bool at_end() const
+	{
+		return cur_ >= end_;
+	}
+
+	// skip spaces and tabs (but not the end of the line)
+	inline void skip_blanks()
+	{
+		while (cur_ < end_ && (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\r'))
+			++cur_;
+	}
+
+	// skip blanks, line ends and comment lines
+	inline void skip_whitespaces()
+	{
+		while (cur_ < end_)
+		{
+			if (*cur_ == '#')
+				next_line();
+			else if (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\r' || *cur_ == '\n')
+				++cur_;
+			else
+				break;
+		}
+	}
+
+	// true if the rest of the current line is blank or a comment
+	inline bool end_of_line()
+	{
+		skip_blanks();
+		return cur_ >= end_ || *cur_ == '\n' || *cur_ == '#';
+	}
+
+	// true if the current line (from the current position) contains data
+	inline bool data_line()
+	{
+		return !end_of_line();
+	}
+
+	// move to the beginning of the next line
+	inline void next_line()
+	{
+		const char* eol = static_cast<const char*>(std::memchr(cur_, '\n', std::size_t(end_ - cur_)));
+		cur_ = eol ? eol + 1 : end_;
+	}
+
+	// true (and skip it) if the current line starts with the given keyword followed by a blank
+	inline bool keyword(const char* word)
+	{
+		skip_blanks();
+		const std::size_t length = std::strlen(word);
+		if (std::size_t(end_ - cur_) > length && std::memcmp(cur_, word, length) == 0 &&
+			(cur_[length] == ' ' || cur_[length] == '\t'))
+		{
+			cur_ += length;
+			return true;
+		}
+		return false;
+	}
+
+	// skip the characters up to the next blank or line end
+	inline void skip_word()
+	{
+		while (cur_ < end_ && *cur_ != ' ' && *cur_ != '\t' && *cur_ != '\r' && *cur_ != '\n')
+			++cur_;
+	}
+
+	template <typename T>
+	inline bool read(T& value)
+	{
+		skip_blanks();
+		const char* begin = cur_;
+		if (begin < end_ && *begin == '+')
+			++begin;
+#if defined(__cpp_lib_to_chars)
+		const auto [ptr, ec] = std::from_chars(begin, end_, value);
+		if (ec != std::errc())
+			return false;
+		cur_ = ptr;
+		return true;
+#else
+		if constexpr (std::is_integral_v<T>)
+		{
+			const auto [ptr, ec] = std::from_chars(begin, end_, value);
+			if (ec != std::errc())
+				return false;
+			cur_ = ptr;
+			return true;
+		}
+		else
+		{
+			// no floating point from_chars: copy the token (the text is not null terminated)
+			char buffer[64];
+			std::size_t length = 0u;
+			while (begin + length < end_ && length < sizeof(buffer) - 1u &&
+				   std::strchr("0123456789+-.eEinfatyINFATY", begin[length]) != nullptr)
+				++length;
+			std::memcpy(buffer, begin, length);
+			buffer[length] = '\0';
+			char* ptr;
+			value = T(std::strtod(buffer, &ptr));
+			if (ptr == buffer)
+				return false;
+			cur_ = begin + (ptr - buffer);
+			return true;
+		}
+#endif
+	}
+};
+
+/**
+ * @brief split the text [begin, end) into at most nb_chunks ranges that start at the beginning of a line
+ * @return the nb + 1 bounds of the nb ranges
+ */
+inline std::vector<const char*> split_lines(const char* begin, const char* end, uint32 nb_chunks)
+{
+	std::vector<const char*> bounds;
+	bounds.reserve(nb_chunks + 1u);
+	bounds.push_back(begin);
+	const std::size_t size = std::size_t(end - begin);
+	for (uint32 i = 1u; i < nb_chunks; ++i)
+	{
+		const char* p = std::max(begin + size * i / nb_chunks, bounds.back());
+		const char* eol = static_cast<const char*>(std::memchr(p, '\n', std::size_t(end - p)));
+		p = eol ? eol + 1 : end;
+		if (p > bounds.back() && p < end)
+			bounds.push_back(p);
+	}
+	bounds.push_back(end);
+	return bounds;
+}
+
+// number of chunks used to parse a text of the given size with the workers of the thread pool
+inline uint32 nb_text_chunks(std::size_t size)
+{
+	const std::size_t min_chunk_size = 1u << 20u;
+	const uint32 max_nb_chunks = 4u * std::max(thread_pool()->nb_workers(), 1u);
+	return uint32(std::max<std::size_t>(1u, std::min<std::size_t>(size / min_chunk_size, max_nb_chunks)));
+}
+
+/**
+ * @brief apply f(chunk_index, tokenizer) on each chunk of text defined by bounds, with the workers of the thread pool
+ */
+template <typename FUNC>
+void parallel_foreach_text_chunk(const std::vector<const char*>& bounds, const FUNC& f)
+{
+	parallel_foreach_range(
+		0u, uint32(bounds.size()) - 1u,
+		[&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+			{
+				TextTokenizer tokenizer(bounds[i], bounds[i + 1]);
+				f(i, tokenizer);
+			}
+		},
+		1u);
+}
+
+/**
+ * @brief number of data lines in each chunk of text defined by bounds
+ * @return the exclusive prefix sums of these numbers, i.e. the rank of the first data line of each chunk
+ * (the last value is the total number of data lines)
+ */
+inline std::vector<uint32> data_lines_ranks(const std::vector<const char*>& bounds)
+{
+	const uint32 nb_chunks = uint32(bounds.size()) - 1u;
+	std::vector<uint32> ranks(nb_chunks + 1u, 0u);
+	parallel_foreach_text_chunk(bounds, [&](uint32 chunk, TextTokenizer& t) {
+		uint32 nb = 0u;
+		while (!t.at_end())
+		{
+			if (t.data_line())
+				++nb;
+			t.next_line();
+		}
+		ranks[chunk + 1u] = nb;
+	});
+	for (uint32 i = 0u; i < nb_chunks; ++i)
+		ranks[i + 1u] += ranks[i];
+	return ranks;
+}
+
+/**
+ * @brief concatenate (in parallel) the per chunk vectors in result
+ */
+template <typename T>
+void parallel_concatenate(const std::vector<std::vector<T>>& chunks, std::vector<T>& result)
+{
+	std::vector<std::size_t> offsets(chunks.size() + 1u, 0u);
+	for (std::size_t i = 0u; i < chunks.size(); ++i)
+		offsets[i + 1u] = offsets[i] + chunks[i].size();
+	const std::size_t first = result.size();
+	result.resize(first + offsets.back());
+	parallel_foreach_range(
+		0u, uint32(chunks.size()),
+		[&](uint32 begin, uint32 end) {
+			for (uint32 i = begin; i < end; ++i)
+				std::copy(chunks[i].begin(), chunks[i].end(), result.begin() + first + offsets[i]);
+		},
+		1u);
+}
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_TEXT_PARSER_H_
@@ -24,7 +24,8 @@
 #ifndef CGOGN_IO_VOLUME_TET_H_
 #define CGOGN_IO_VOLUME_TET_H_
 
-#include <cgogn/io/utils.h>
+#include <cgogn/io/mapped_file.h>
+#include <cgogn/io/text_parser.h>
 #include <cgogn/io/volume/volume_import.h>
 
 #include <cgogn/core/functions/attributes.h>
@@ -34,7 +35,7 @@
 #include <cgogn/geometry/functions/orientation.h>
 #include <cgogn/geometry/types/vector_traits.h>
 
-#include <fstream>
+#include <atomic>
 #include <vector>
 
 namespace cgogn
@@ -43,6 +44,52 @@ namespace cgogn
 namespace io
 {
 
+/**
+ * @brief reorder the vertices of a volume of the given type so that it is correctly oriented
+ */
+template <typename MESH>
+void orient_volume(const typename mesh_traits<MESH>::template Attribute<geometry::Vec3>& position, VolumeType type,
+				   uint32* ids)
+{
+	switch (type)
+	{
+	case VolumeType::Tetra:
+		if (geometry::test_orientation_3D(position[ids[0]], position[ids[1]], position[ids[2]], position[ids[3]]) ==
+			geometry::Orientation3D::UNDER)
+			std::swap(ids[1], ids[2]);
+		break;
+	case VolumeType::Pyramid:
+		if (geometry::test_orientation_3D(position[ids[4]], position[ids[0]], position[ids[1]], position[ids[2]]) ==
+			geometry::Orientation3D::OVER)
+			std::swap(ids[1], ids[3]);
+		break;
+	case VolumeType::TriangularPrism:
+		if (geometry::test_orientation_3D(position[ids[3]], position[ids[0]], position[ids[1]], position[ids[2]]) ==
+			geometry::Orientation3D::OVER)
+		{
+			std::swap(ids[1], ids[2]);
+			std::swap(ids[4], ids[5]);
+		}
+		break;
+	case VolumeType::Hexa:
+		if (geometry::test_orientation_3D(position[ids[4]], position[ids[0]], position[ids[1]], position[ids[2]]) ==
+			geometry::Orientation3D::OVER)
+		{
+			std::swap(ids[0], ids[3]);
+			std::swap(ids[1], ids[2]);
+			std::swap(ids[4], ids[7]);
+			std::swap(ids[5], ids[6]);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief import a TET file (one vertex or volume per line)
+ * The file is mapped in memory and split into chunks of lines that are parsed in parallel.
+ */
 template <typename MESH>
 bool import_TET(MESH& m, const std::string& filename)
 {
@@ -50,21 +97,29 @@ bool import_TET(MESH& m, const std::string& filename)
 
 	using Vertex = typename MESH::Vertex;
 
-	Scoped_C_Locale loc;
-
-	VolumeImportData volume_data;
-
-	std::ifstream fp(filename, std::ios::in);
+	std::shared_ptr<MappedFile> file = MappedFile::open(filename);
+	if (!file)
+	{
+		std::cerr << "Unable to open file \"" << filename << "\"." << std::endl;
+		return false;
+	}
 
-	std::string line;
-	line.reserve(512u);
+	TextTokenizer header(file->data(), file->data() + file->size());
 
-	// read number of vertices
-	uint32 nb_vertices = read_uint(fp, line);
-	getline_safe(fp, line);
+	// read number of vertices & volumes
+	uint32 nb_vertices = 0u, nb_volumes = 0u;
+	header.skip_whitespaces();
+	bool valid = header.read(nb_vertices);
+	header.next_line();
+	header.skip_whitespaces();
+	valid &= header.read(nb_volumes);
+	header.next_line();
 
-	uint32 nb_volumes = read_uint(fp, line);
-	getline_safe(fp, line);
+	if (!valid)
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid tet file." << std::endl;
+		return false;
+	}
 
 	if (nb_vertices == 0u)
 	{
@@ -72,81 +127,114 @@ bool import_TET(MESH& m, const std::string& filename)
 		return false;
 	}
 
+	VolumeImportData volume_data;
 	volume_data.reserve(nb_vertices, nb_volumes);
 	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
 
-	// read vertices position
 	for (uint32 i = 0u; i < nb_vertices; ++i)
-	{
-		float64 x = read_double(fp, line);
-		float64 y = read_double(fp, line);
-		float64 z = read_double(fp, line);
+		volume_data.vertices_id_.push_back(new_index<Vertex>(m));
 
-		uint32 vertex_id = new_index<Vertex>(m);
-		(*position)[vertex_id] = {x, y, z};
-
-		volume_data.vertices_id_.push_back(vertex_id);
+	const std::vector<const char*> bounds =
+		split_lines(header.position(), file->data() + file->size(), nb_text_chunks(file->size()));
+	const std::vector<uint32> ranks = data_lines_ranks(bounds);
+	if (ranks.back() < nb_vertices + nb_volumes)
+	{
+		std::cerr << "File \"" << filename << "\" is truncated." << std::endl;
+		return false;
 	}
 
-	// read volumes
-	for (uint32 i = 0u; i < nb_volumes; ++i)
-	{
-		uint32 n = read_uint(fp, line);
-		std::vector<uint32> ids(n);
-		for (uint32 j = 0u; j < n; ++j)
-			ids[j] = volume_data.vertices_id_[read_uint(fp, line)];
+	const uint32 nb_chunks = uint32(bounds.size()) - 1u;
+	std::vector<std::vector<VolumeType>> volumes_types(nb_chunks);
+	std::vector<std::vector<uint32>> volumes_vertex_indices(nb_chunks);
+	std::atomic<bool> valid_chunks = true;
+	std::atomic<uint32> nb_ignored = 0u;
 
-		switch (n)
+	parallel_foreach_text_chunk(bounds, [&](uint32 chunk, TextTokenizer& t) {
+		std::vector<VolumeType>& chunk_volumes_types = volumes_types[chunk];
+		std::vector<uint32>& chunk_volumes_vertex_indices = volumes_vertex_indices[chunk];
+		for (uint32 l = ranks[chunk]; !t.at_end() && l < nb_vertices + nb_volumes; t.next_line())
 		{
-		case 4: {
-			if (geometry::test_orientation_3D((*position)[ids[0]], (*position)[ids[1]], (*position)[ids[2]],
-											  (*position)[ids[3]]) == geometry::Orientation3D::UNDER)
-				std::swap(ids[1], ids[2]);
-			volume_data.volumes_types_.push_back(VolumeType::Tetra);
-			volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(),
-													   ids.end());
-			break;
-		}
-		case 5: {
-			if (geometry::test_orientation_3D((*position)[ids[4]], (*position)[ids[0]], (*position)[ids[1]],
-											  (*position)[ids[2]]) == geometry::Orientation3D::OVER)
-				std::swap(ids[1], ids[3]);
-			volume_data.volumes_types_.push_back(VolumeType::Pyramid);
-			volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(),
-													   ids.end());
-			break;
-		}
-		case 6: {
-			if (geometry::test_orientation_3D((*position)[ids[3]], (*position)[ids[0]], (*position)[ids[1]],
-											  (*position)[ids[2]]) == geometry::Orientation3D::OVER)
+			if (!t.data_line())
+				continue;
+			if (l < nb_vertices)
 			{
-				std::swap(ids[1], ids[2]);
-				std::swap(ids[4], ids[5]);
+				// read vertex position
+				float64 x = 0.0, y = 0.0, z = 0.0;
+				if (!t.read(x) || !t.read(y) || !t.read(z))
+					valid_chunks = false;
+				(*position)[volume_data.vertices_id_[l]] = {x, y, z};
 			}
-			volume_data.volumes_types_.push_back(VolumeType::TriangularPrism);
-			volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(),
-													   ids.end());
-			break;
-		}
-		case 8: {
-			if (geometry::test_orientation_3D((*position)[ids[4]], (*position)[ids[0]], (*position)[ids[1]],
-											  (*position)[ids[2]]) == geometry::Orientation3D::OVER)
+			else
 			{
-				std::swap(ids[0], ids[3]);
-				std::swap(ids[1], ids[2]);
-				std::swap(ids[4], ids[7]);
-				std::swap(ids[5], ids[6]);
+				// read volume
+				uint32 n = 0u;
+				if (!t.read(n))
+					valid_chunks = false;
+				VolumeType type;
+				switch (n)
+				{
+				case 4:
+					type = VolumeType::Tetra;
+					break;
+				case 5:
+					type = VolumeType::Pyramid;
+					break;
+				case 6:
+					type = VolumeType::TriangularPrism;
+					break;
+				case 8:
+					type = VolumeType::Hexa;
+					break;
+				default:
+					++nb_ignored;
+					++l;
+					continue;
+				}
+				for (uint32 j = 0u; j < n; ++j)
+				{
+					uint32 index = 0u;
+					if (!t.read(index) || index >= nb_vertices)
+					{
+						valid_chunks = false;
+						index = 0u;
+					}
+					chunk_volumes_vertex_indices.push_back(volume_data.vertices_id_[index]);
+				}
+				chunk_volumes_types.push_back(type);
 			}
-			volume_data.volumes_types_.push_back(VolumeType::Hexa);
-			volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(),
-													   ids.end());
-			break;
-		}
-		default:
-			std::cout << "import_TET: Elements with " << n << " vertices are not handled. Ignoring.";
-			break;
+			++l;
 		}
+	});
+
+	if (!valid_chunks)
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid tet file." << std::endl;
+		return false;
 	}
+	if (nb_ignored > 0u)
+		std::cout << "import_TET: " << nb_ignored << " elements with a non handled number of vertices were ignored."
+				  << std::endl;
+
+	// all the positions are known: fix the volumes orientation
+	parallel_foreach_range(
+		0u, nb_chunks,
+		[&](uint32 begin, uint32 end) {
+			// number of vertices of Tetra, Pyramid, TriangularPrism & Hexa
+			static const uint32 nb_volume_vertices[] = {4u, 5u, 6u, 8u};
+			for (uint32 chunk = begin; chunk < end; ++chunk)
+			{
+				uint32* ids = volumes_vertex_indices[chunk].data();
+				for (VolumeType type : volumes_types[chunk])
+				{
+					orient_volume<MESH>(*position, type, ids);
+					ids += nb_volume_vertices[type];
+				}
+			}
+		},
+		1u);
+
+	parallel_concatenate(volumes_types, volume_data.volumes_types_);
+	parallel_concatenate(volumes_vertex_indices, volume_data.volumes_vertex_indices_);
 
 	import_volume_data(m, volume_data);
 
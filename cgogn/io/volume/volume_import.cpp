@@ -29,7 +29,11 @@
 #include <cgogn/core/types/mesh_traits.h>
 
 #include <cgogn/core/types/cmap/cmap_ops.h>
+#include <cgogn/core/utils/work_stealing.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <vector>
 
 namespace cgogn
@@ -43,10 +47,44 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 	using Vertex = CMap3::Vertex;
 	using Volume = CMap3::Volume;
 
-	auto darts_per_vertex = add_attribute<std::vector<Dart>, Vertex>(m, "__darts_per_vertex");
+	// faces of the created volumes: the vertices of a face (triangle or quad) are listed from its smallest vertex,
+	// in the order of its darts (forward) or in the reverse order (backward), so that the key of a face is equal
+	// to the key of its opposite face, that has the reverse orientation
+	struct FaceKey
+	{
+		std::array<uint32, 4> vertices; // INVALID_INDEX for the 4th vertex of a triangle
+		Dart dart;						// dart of the face starting at its smallest vertex
+		bool forward;
+	};
+	std::vector<FaceKey> faces;
+	faces.reserve(volume_data.volumes_types_.size() * 6u);
+
+	auto add_face_key = [&](Dart d) {
+		std::array<Dart, 4> darts;
+		std::array<uint32, 4> vertices;
+		uint32 nbv = 0u;
+		uint32 first = 0u;
+		Dart it = d;
+		do
+		{
+			darts[nbv] = it;
+			vertices[nbv] = index_of(m, Vertex(it));
+			if (vertices[nbv] < vertices[first])
+				first = nbv;
+			++nbv;
+			it = phi1(m, it);
+		} while (it != d);
+
+		FaceKey f;
+		f.vertices.fill(INVALID_INDEX);
+		f.dart = darts[first];
+		f.forward = vertices[(first + 1u) % nbv] < vertices[(first + nbv - 1u) % nbv];
+		for (uint32 i = 0u; i < nbv; ++i)
+			f.vertices[i] = vertices[(f.forward ? first + i : first + nbv - i) % nbv];
+		faces.push_back(f);
+	};
 
 	uint32 index = 0u;
-	DartMarker dart_marker(m);
 	uint32 vol_emb = 0u;
 
 	// for each volume of table
@@ -69,14 +107,6 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 					set_index<Vertex>(m, d, vertex_index);
 					return true;
 				});
-
-				Dart dd = dv;
-				do
-				{
-					dart_marker.mark(dd);
-					(*darts_per_vertex)[vertex_index].push_back(dd);
-					dd = phi1(m, phi2(m, dd));
-				} while (dd != dv);
 			}
 		}
 		else if (vol_type == VolumeType::Pyramid) // pyramidal case
@@ -93,14 +123,6 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 					set_index<Vertex>(m, d, vertex_index);
 					return true;
 				});
-
-				Dart dd = dv;
-				do
-				{
-					dart_marker.mark(dd);
-					(*darts_per_vertex)[vertex_index].push_back(dd);
-					dd = phi1(m, phi2(m, dd));
-				} while (dd != dv);
 			}
 		}
 		else if (vol_type == VolumeType::TriangularPrism) // prism case
@@ -121,14 +143,6 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 					set_index<Vertex>(m, d, vertex_index);
 					return true;
 				});
-
-				Dart dd = dv;
-				do
-				{
-					dart_marker.mark(dd);
-					(*darts_per_vertex)[vertex_index].push_back(dd);
-					dd = phi1(m, phi2(m, dd));
-				} while (dd != dv);
 			}
 		}
 		else if (vol_type == VolumeType::Hexa) // hexahedral case
@@ -152,14 +166,6 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 					set_index<Vertex>(m, d, vertex_index);
 					return true;
 				});
-
-				Dart dd = dv;
-				do
-				{
-					dart_marker.mark(dd);
-					(*darts_per_vertex)[vertex_index].push_back(dd);
-					dd = phi1(m, phi2(m, dd));
-				} while (dd != dv);
 			}
 		}
 		else // end of hexa
@@ -171,75 +177,162 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 			}
 		}
 
+		if (vol.is_valid())
+		{
+			// base face, side faces and top face (prisms)
+			add_face_key(vol.dart);
+			Dart d = vol.dart;
+			do
+			{
+				add_face_key(phi2(m, d));
+				d = phi1(m, d);
+			} while (d != vol.dart);
+			if (vol_type == VolumeType::TriangularPrism || vol_type == VolumeType::Hexa)
+				add_face_key(phi2(m, phi1(m, phi1(m, phi2(m, vol.dart)))));
+		}
+
 		if (is_indexed<Volume>(m))
 			set_index(m, vol, vol_emb++);
 	}
 
-	// reconstruct neighbourhood
-	uint32 nb_boundary_faces = 0u;
-	DartMarkerStore marker(m);
+	// sort the faces by their smallest vertex (counting sort)
+	// the order of the faces inside a bucket depends on the scheduling: buckets are sorted afterwards
+
+	const uint32 nb_faces = uint32(faces.size());
+	const uint32 nb_vertices = maximum_index<Vertex>(m);
 
-	for (Dart d = m.begin(), end = m.end(); d != end; d = m.next(d))
+	std::vector<std::atomic<uint32>> bucket_positions(nb_vertices);
+	parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+			bucket_positions[faces[i].vertices[0]].fetch_add(1u, std::memory_order_relaxed);
+	});
+
+	std::vector<uint32> buckets_offsets(nb_vertices + 1u);
+	buckets_offsets[0] = 0u;
+	for (uint32 v = 0u; v < nb_vertices; ++v)
 	{
-		if (phi3(m, d) == d && !marker.is_marked(d))
+		buckets_offsets[v + 1u] = buckets_offsets[v] + bucket_positions[v].load(std::memory_order_relaxed);
+		bucket_positions[v].store(buckets_offsets[v], std::memory_order_relaxed);
+	}
+
+	std::vector<uint32> buckets(nb_faces);
+	parallel_foreach_range(0u, nb_faces, [&](uint32 begin, uint32 end) {
+		for (uint32 i = begin; i < end; ++i)
+			buckets[bucket_positions[faces[i].vertices[0]].fetch_add(1u, std::memory_order_relaxed)] = i;
+	});
+
+	// in each bucket, the faces with the same key are consecutive once sorted by their keys
+	// the forward faces are sewn to the backward ones, pairing them in the order of their creation
+	// more than one face in a direction means that the face is non manifold: the remaining ones stay unsewn
+
+	std::vector<uint8> sewn(nb_faces, 0u);
+	std::atomic<uint32> nb_boundary_faces = 0u;
+	std::atomic<uint32> nb_non_manifold_faces = 0u;
+
+	parallel_foreach_range(0u, nb_vertices, [&](uint32 begin, uint32 end) {
+		std::vector<uint32> forward_faces;
+		std::vector<uint32> backward_faces;
+		uint32 nb_boundary = 0u;
+		uint32 nb_non_manifold = 0u;
+
+		for (uint32 v = begin; v < end; ++v)
 		{
-			foreach_dart_of_orbit(m, CMap3::Face2(d), [&](Dart fd) -> bool {
-				marker.mark(fd);
-				return true;
+			auto first = buckets.begin() + buckets_offsets[v];
+			auto last = buckets.begin() + buckets_offsets[v + 1u];
+			// faces indices follow the creation order of the darts
+			std::sort(first, last, [&](uint32 i, uint32 j) {
+				return faces[i].vertices < faces[j].vertices || (faces[i].vertices == faces[j].vertices && i < j);
 			});
 
-			Dart good_dart;
-
-			// 1st step : for every dart of the face we try to find a valid phi3 candidate. If we can't it's a boundary
-			// face.
-			Dart d_it = d;
-			do
+			while (first != last)
 			{
-				uint32 vindex1 = index_of(m, Vertex(d_it));
-				uint32 vindex2 = index_of(m, Vertex(phi1(m, phi1(m, d_it))));
-				const std::vector<Dart>& vec = value<std::vector<Dart>>(m, darts_per_vertex, Vertex(phi1(m, d_it)));
-				for (auto it = vec.begin(); it != vec.end() && good_dart.is_nil(); ++it)
-					if (index_of(m, Vertex(phi1(m, *it))) == vindex1 && index_of(m, Vertex(phi_1(m, *it))) == vindex2)
-						good_dart = *it;
-				d_it = phi1(m, d_it);
-			} while (good_dart.is_nil() && (d_it != d));
-			d = phi_1(m, d_it);
-
-			if (!good_dart.is_nil())
-			{
-				const uint32 degD = codegree(m, CMap3::Face(d));
-				const uint32 degGD = codegree(m, CMap3::Face(good_dart));
+				const std::array<uint32, 4>& key = faces[*first].vertices;
+				forward_faces.clear();
+				backward_faces.clear();
+				for (; first != last && faces[*first].vertices == key; ++first)
+				{
+					if (faces[*first].forward)
+						forward_faces.push_back(*first);
+					else
+						backward_faces.push_back(*first);
+				}
 
-				if (degD == degGD) // normal case : the two opposite faces have the same degree
+				const uint32 nb_pairs = uint32(std::min(forward_faces.size(), backward_faces.size()));
+				for (uint32 i = 0u; i < nb_pairs; ++i)
 				{
+					// the forward face goes from its smallest vertex to the next one in the key,
+					// its opposite dart in the backward face ends at the smallest vertex
+					const Dart d = faces[forward_faces[i]].dart;
 					Dart it1 = d;
-					Dart it2 = good_dart;
+					Dart it2 = phi_1(m, faces[backward_faces[i]].dart);
 					do
 					{
 						phi3_sew(m, it1, it2);
 						it1 = phi1(m, it1);
 						it2 = phi_1(m, it2);
 					} while (it1 != d);
+					sewn[forward_faces[i]] = 1u;
+					sewn[backward_faces[i]] = 1u;
 				}
-				else
-				{
-					// there is one face of degree 4 and one face of degree 3
-					// -> stamp volume
-				}
+				nb_boundary += uint32(forward_faces.size() + backward_faces.size()) - 2u * nb_pairs;
+				if (forward_faces.size() > 1u || backward_faces.size() > 1u)
+					++nb_non_manifold;
 			}
-			else
-				++nb_boundary_faces;
 		}
-	}
+
+		nb_boundary_faces += nb_boundary;
+		nb_non_manifold_faces += nb_non_manifold;
+	});
+
+	if (nb_non_manifold_faces > 0u)
+		std::cout << nb_non_manifold_faces << " non manifold face(s) have not been sewn" << std::endl;
+
+	// a boundary quad that has 3 of its vertices in common with a boundary triangle is a non conforming face
+	// (the junction of a quad face and a triangle face): no stamp volume is inserted, both faces are closed
 
 	if (nb_boundary_faces > 0u)
 	{
+		std::vector<std::array<uint32, 3>> boundary_triangles;
+		std::vector<uint32> boundary_quads;
+		for (uint32 i = 0u; i < nb_faces; ++i)
+		{
+			if (sewn[i])
+				continue;
+			std::array<uint32, 4> key = faces[i].vertices;
+			if (key[3] == INVALID_INDEX)
+			{
+				std::sort(key.begin(), key.begin() + 3);
+				boundary_triangles.push_back({key[0], key[1], key[2]});
+			}
+			else
+				boundary_quads.push_back(i);
+		}
+		std::sort(boundary_triangles.begin(), boundary_triangles.end());
+
+		uint32 nb_non_conforming_quads = 0u;
+		for (uint32 i : boundary_quads)
+		{
+			std::array<uint32, 4> key = faces[i].vertices;
+			std::sort(key.begin(), key.end());
+			for (uint32 j = 0u; j < 4u; ++j)
+			{
+				std::array<uint32, 3> triangle;
+				std::copy_if(key.begin(), key.end(), triangle.begin(), [&](uint32 v) { return v != key[j]; });
+				if (std::binary_search(boundary_triangles.begin(), boundary_triangles.end(), triangle))
+				{
+					++nb_non_conforming_quads;
+					break;
+				}
+			}
+		}
+
+		if (nb_non_conforming_quads > 0u)
+			std::cout << nb_non_conforming_quads << " non conforming quad face(s) have not been sewn" << std::endl;
+
 		uint32 nb_holes = close(m);
 		std::cout << nb_holes << " hole(s) have been closed" << std::endl;
 		std::cout << nb_boundary_faces << " boundary faces" << std::endl;
 	}
-
-	remove_attribute<Vertex>(m, darts_per_vertex);
 }
 
 } // namespace io
@@ -277,6 +277,8 @@ void shift_frame(Mat3& frame, uint32 nb_shifts)
 
 void dualize_volume(CMap2& m, CMap2::Volume vol, M2Attributes& m2Attribs, const Graph& g, GAttributes& gAttribs)
 {
+	m.invalidate_nb_cells();
+
 	// set the new phi1
 	foreach_dart_of_orbit(m, vol, [&](Dart d) -> bool {
 		Dart dd = phi2(m, phi_1(m, d));
@@ -349,7 +351,7 @@ void bloat(CMap3& m3, const Graph& g, const GAttributes& gAttribs)
 		if (degree(g, gv) == 1)
 		{
 			Vec3 p0 = value<Vec3>(g, gAttribs.vertex_position, gv);
-			std::vector<Graph::Vertex> neigh = adjacent_vertices_through_edge(g, gv);
+			CellsSmallVector<Graph::Vertex> neigh = adjacent_vertices_through_edge(g, gv);
 			Vec3 p1 = value<Vec3>(g, gAttribs.vertex_position, neigh[0]);
 			Vec3 offset = (p0 - p1).normalized() * value<Scalar>(g, gAttribs.vertex_radius, gv);
 			CMap3::Vertex v3 =
@@ -1265,7 +1267,7 @@ bool set_contact_surfaces_geometry(const Graph& g, const GAttributes& gAttribs,
 		}
 
 		foreach_incident_edge(m2, contact_surface, [&](CMap2::Edge e) -> bool {
-			std::vector<CMap2::Vertex> vertices = incident_vertices(m2, e);
+			CellsSmallVector<CMap2::Vertex> vertices = incident_vertices(m2, e);
 			Vec3 mid = 0.5 * (value<Vec3>(m2, m2Attribs.vertex_position, vertices[0]) +
 							  value<Vec3>(m2, m2Attribs.vertex_position, vertices[1]));
 			geometry::project_on_sphere(mid, center, radius);
@@ -1322,7 +1324,7 @@ bool set_contact_surfaces_geometry_from_surface(const Graph& g, const GAttribute
 		}
 
 		foreach_incident_edge(m2, contact_surface, [&](CMap2::Edge e) -> bool {
-			std::vector<CMap2::Vertex> vertices = incident_vertices(m2, e);
+			CellsSmallVector<CMap2::Vertex> vertices = incident_vertices(m2, e);
 			Vec3 mid = 0.5 * (value<Vec3>(m2, m2Attribs.vertex_position, vertices[0]) +
 							  value<Vec3>(m2, m2Attribs.vertex_position, vertices[1]));
 			std::vector<SelectedFace> selectedfaces =
@@ -1963,7 +1965,7 @@ void subdivide_length_wise(CMap3& m3, M3Attributes& m3Attribs, CellMarker<CMap3,
 	});
 
 	cut_all_edges(cache_edge2cut, [&](Vertex v) {
-		std::vector<Vertex> vertices = adjacent_vertices_through_edge(m3, v);
+		CellsSmallVector<Vertex> vertices = adjacent_vertices_through_edge(m3, v);
 		Vec3 mid = (value<Vec3>(m3, m3Attribs.vertex_position, vertices[0]) +
 					value<Vec3>(m3, m3Attribs.vertex_position, vertices[1])) *
 				   Scalar(0.5);
@@ -2121,7 +2123,7 @@ void cut_chunk(CMap3& m3, M3Attributes& m3Attribs, CellMarker<CMap3, CMap3::Face
 	}
 
 	foreach_cell(cache_edge2cut, [&](Edge e) -> bool {
-		std::vector<Vertex> vertices = incident_vertices(m3, e);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m3, e);
 		Vertex v_mid = cut_edge(m3, e);
 		value<Vec3>(m3, m3Attribs.vertex_position, v_mid) =
 			(1 - slice) * value<Vec3>(m3, m3Attribs.vertex_position, vertices[0]) +
@@ -2216,7 +2218,7 @@ void trisect_length_wise(CMap3& m3, M3Attributes& m3Attribs, CellMarker<CMap3, C
 	});
 
 	foreach_cell(cache_edge2cut, [&](Edge e) -> bool {
-		std::vector<Vertex> vertices = incident_vertices(m3, e);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m3, e);
 		Vertex v_mid = cut_edge(m3, e);
 		value<Vec3>(m3, m3Attribs.vertex_position, v_mid) =
 			0.5 * (value<Vec3>(m3, m3Attribs.vertex_position, vertices[0]) +
@@ -2243,7 +2245,7 @@ void trisect_length_wise(CMap3& m3, M3Attributes& m3Attribs, CellMarker<CMap3, C
 		Vec3 center = value<Vec3>(m3, centroids, f);
 		Dart d1 = phi1(m3, f.dart);
 		Edge e = cut_face(m3, Vertex(phi1(m3, f.dart)), Vertex(phi_1(m3, f.dart)));
-		std::vector<Vertex> vertices = incident_vertices(m3, e);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m3, e);
 		Vertex center_vertex = cut_edge(m3, e);
 		value<Vec3>(m3, m3Attribs.vertex_position, center_vertex) = center;
 
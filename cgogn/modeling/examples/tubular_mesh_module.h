@@ -120,7 +120,7 @@ protected:
 		foreach_cell(*graph_, [&](GraphVertex v) -> bool {
 			if (degree(*graph_, v) == 1)
 			{
-				std::vector<GraphVertex> av = adjacent_vertices_through_edge(*graph_, v);
+				CellsSmallVector<GraphVertex> av = adjacent_vertices_through_edge(*graph_, v);
 				const Vec3& p = value<Vec3>(*graph_, graph_vertex_position_, v);
 				const Vec3& q = value<Vec3>(*graph_, graph_vertex_position_, av[0]);
 				Vec3 dir = p - q;
@@ -33,6 +33,7 @@
 
 #include <GL/gl3w.h>
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <string>
@@ -44,6 +45,29 @@ namespace cgogn
 namespace rendering
 {
 
+namespace internal
+{
+
+// components of the nb values starting at values, as float32 (buffer is resized)
+template <typename VEC>
+void convert_to_float32(const VEC* values, uint32 nb, std::vector<float32>& buffer)
+{
+	static const std::size_t element_size = geometry::vector_traits<VEC>::SIZE;
+	buffer.resize(nb * element_size);
+	for (uint32 i = 0; i < nb; ++i)
+	{
+		if constexpr (element_size == 1)
+			buffer[i] = float32(values[i]);
+		else
+		{
+			for (std::size_t k = 0; k < element_size; ++k)
+				buffer[i * element_size + k] = float32(values[i][k]);
+		}
+	}
+}
+
+} // namespace internal
+
 /////////////////
 // std::vector //
 /////////////////
@@ -198,6 +222,42 @@ void update_vbo(const Vector<VEC>* attribute, VBO* vbo)
 	}
 }
 
+/**
+ * @brief update the parts of a vbo built from a Vector<VEC> that were modified after the given version
+ * (the whole vbo is updated if its size does not match the attribute anymore)
+ * @param attribute
+ * @param vbo vbo to update
+ * @param since_version version of the attribute the vbo was built from
+ * @return the version of the attribute the vbo is now built from
+ */
+template <typename VEC>
+uint64 update_vbo(const Vector<VEC>* attribute, VBO* vbo, uint64 since_version)
+{
+	static const std::size_t element_size = geometry::vector_traits<VEC>::SIZE;
+	const uint32 nb_elements = attribute->maximum_index();
+	if (vbo->size() != nb_elements || vbo->vector_dimension() != int32(element_size))
+	{
+		update_vbo(attribute, vbo);
+		return attribute->version();
+	}
+
+	std::vector<float32> buffer;
+	vbo->bind();
+	attribute->foreach_modified_range(since_version, [&](uint32 begin, uint32 end) {
+		if constexpr (std::is_same<typename geometry::vector_traits<VEC>::Scalar, float32>::value)
+			vbo->copy_data(uint32(begin * element_size * sizeof(float32)),
+						   (end - begin) * element_size * sizeof(float32), &(*attribute)[begin]);
+		else
+		{
+			internal::convert_to_float32(&(*attribute)[begin], end - begin, buffer);
+			vbo->copy_data(uint32(begin * element_size * sizeof(float32)), buffer.size() * sizeof(float32),
+						   buffer.data());
+		}
+	});
+	vbo->release();
+	return attribute->version();
+}
+
 ////////////////
 // ChunkArray //
 ////////////////
@@ -282,6 +342,52 @@ void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo)
 	}
 }
 
+/**
+ * @brief update the parts of a vbo built from a ChunkArray<VEC> that were modified after the given version
+ * (the whole vbo is updated if its size does not match the attribute anymore)
+ * @param attribute
+ * @param vbo vbo to update
+ * @param since_version version of the attribute the vbo was built from
+ * @return the version of the attribute the vbo is now built from
+ */
+template <typename VEC>
+uint64 update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo, uint64 since_version)
+{
+	static const std::size_t element_size = geometry::vector_traits<VEC>::SIZE;
+	static const uint32 chunk_size = ChunkArray<VEC>::CHUNK_SIZE;
+	// float32 attributes are uploaded by whole chunks, the others are converted up to maximum_index
+	const uint32 nb_elements =
+		std::is_same<typename geometry::vector_traits<VEC>::Scalar, float32>::value
+			? attribute->nb_chunks() * chunk_size
+			: attribute->maximum_index();
+	if (vbo->size() != nb_elements || vbo->vector_dimension() != int32(element_size))
+	{
+		update_vbo(attribute, vbo);
+		return attribute->version();
+	}
+
+	std::vector<float32> buffer;
+	vbo->bind();
+	attribute->foreach_modified_range(since_version, [&](uint32 begin, uint32 end) {
+		// ranges are split at chunk boundaries
+		for (uint32 first = begin; first < end; first = (first / chunk_size + 1u) * chunk_size)
+		{
+			const uint32 last = std::min(end, (first / chunk_size + 1u) * chunk_size);
+			if constexpr (std::is_same<typename geometry::vector_traits<VEC>::Scalar, float32>::value)
+				vbo->copy_data(uint32(first * element_size * sizeof(float32)),
+							   (last - first) * element_size * sizeof(float32), &(*attribute)[first]);
+			else
+			{
+				internal::convert_to_float32(&(*attribute)[first], last - first, buffer);
+				vbo->copy_data(uint32(first * element_size * sizeof(float32)), buffer.size() * sizeof(float32),
+							   buffer.data());
+			}
+		}
+	});
+	vbo->release();
+	return attribute->version();
+}
+
 } // namespace rendering
 
 } // namespace cgogn
@@ -142,7 +142,7 @@ void init_attributes(MESH& m, Attributes<MESH>& swa, Context& swc)
 		if (is_incident_to_boundary(m, e))
 			value<BoundaryCondition>(m, swa.edge_bc_type_, e) = BC_Q;
 
-		std::vector<Vertex> vertices = incident_vertices(m, e);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, e);
 		Vec3 vec =
 			value<Vec3>(m, swa.vertex_position_, vertices[1]) - value<Vec3>(m, swa.vertex_position_, vertices[0]);
 		Scalar l = vec.norm();
@@ -203,7 +203,7 @@ void domain_geometry_changed(MESH& m, Attributes<MESH>& swa, Context& swc)
 	using Face = typename mesh_traits<MESH>::Face;
 
 	parallel_foreach_cell(m, [&](Edge e) -> bool {
-		std::vector<Vertex> vertices = incident_vertices(m, e);
+		CellsSmallVector<Vertex> vertices = incident_vertices(m, e);
 		Vec3 vec =
 			value<Vec3>(m, swa.vertex_position_, vertices[1]) - value<Vec3>(m, swa.vertex_position_, vertices[0]);
 		Scalar l = vec.norm();
@@ -275,28 +275,21 @@ void update_time_step(MESH& m, Attributes<MESH>& swa, Context& swc)
 		return true;
 	});
 
-	std::vector<Scalar> min_dt_per_thread(thread_pool()->nb_workers());
-	// for (Scalar& d : min_dt_per_thread) d = std::min(swc.dt_max_, swc.t_max_ - swc.t_); // Timestep for ending
-	// simulation
-	for (Scalar& d : min_dt_per_thread)
-		d = swc.dt_max_;
-
-	parallel_foreach_cell(m, [&](Face f) -> bool {
-		uint32 fidx = index_of(m, f);
-		uint32 threadidx = current_worker_index();
-		// Ensure CFL condition
-		Scalar cfl = (*swa.face_area_)[fidx] / std::max((*swa.face_swept_)[fidx], swc.small_);
-		min_dt_per_thread[threadidx] = std::min(min_dt_per_thread[threadidx], cfl);
-		// Ensure overdry condition
-		if ((*swa.face_area_)[fidx] * (*swa.face_phi_)[fidx] * ((*swa.face_h_)[fidx] + (*swa.face_zb_)[fidx]) <
-			(-(*swa.face_discharge_)[fidx] * min_dt_per_thread[threadidx]))
-			min_dt_per_thread[threadidx] = -(*swa.face_area_)[fidx] * (*swa.face_phi_)[fidx] *
-										   ((*swa.face_h_)[fidx] + (*swa.face_zb_)[fidx]) /
-										   (*swa.face_discharge_)[fidx];
-		return true;
-	});
-
-	swc.dt_ = *(std::min_element(min_dt_per_thread.begin(), min_dt_per_thread.end()));
+	// Scalar dt_max = std::min(swc.dt_max_, swc.t_max_ - swc.t_); // Timestep for ending simulation
+	swc.dt_ = parallel_reduce_cell(
+		m, swc.dt_max_,
+		[&](Scalar& min_dt, Face f) {
+			uint32 fidx = index_of(m, f);
+			// Ensure CFL condition
+			Scalar cfl = (*swa.face_area_)[fidx] / std::max((*swa.face_swept_)[fidx], swc.small_);
+			min_dt = std::min(min_dt, cfl);
+			// Ensure overdry condition
+			if ((*swa.face_area_)[fidx] * (*swa.face_phi_)[fidx] * ((*swa.face_h_)[fidx] + (*swa.face_zb_)[fidx]) <
+				(-(*swa.face_discharge_)[fidx] * min_dt))
+				min_dt = -(*swa.face_area_)[fidx] * (*swa.face_phi_)[fidx] *
+						 ((*swa.face_h_)[fidx] + (*swa.face_zb_)[fidx]) / (*swa.face_discharge_)[fidx];
+		},
+		[](Scalar a, Scalar b) { return std::min(a, b); });
 }
 
 template <typename MESH>
@@ -324,7 +317,7 @@ void execute_time_step(MESH& m, Attributes<MESH>& swa, Context& swc)
 		}
 		else // Inner cell: use the lateralised Riemann solver
 		{
-			std::vector<Face> faces = incident_faces(m, e);
+			CellsSmallVector<Face> faces = incident_faces(m, e);
 			uint32 f1idx = index_of(m, faces[0]);
 			uint32 f2idx = index_of(m, faces[1]);
 
@@ -30,6 +30,7 @@
 
 #include <cgogn/core/functions/attributes.h>
 #include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/traversals/global.h>
 
 #include <cgogn/rendering/mesh_render.h>
 #include <cgogn/rendering/vbo_update.h>
@@ -151,21 +152,70 @@ public:
 			return;
 		}
 
-		for (uint32 i = 0; i < 3; ++i)
-		{
-			bb_min_[i] = std::numeric_limits<float64>::max();
-			bb_max_[i] = std::numeric_limits<float64>::lowest();
-		}
-		for (const Vec3& p : *bb_vertex_position_)
+		using BB = std::pair<Vec3, Vec3>;
+		const BB empty_bb(Vec3::Constant(std::numeric_limits<float64>::max()),
+						  Vec3::Constant(std::numeric_limits<float64>::lowest()));
+
+		// with a tracked position, the boxes of the modified chunks of indices are recomputed and merged
+		if (bb_vertex_position_->is_modification_tracked())
 		{
-			for (uint32 i = 0; i < 3; ++i)
+			static const uint32 chunk_size = Attribute<Vec3>::MODIFICATION_CHUNK_SIZE;
+			const uint32 nb_chunks = (bb_vertex_position_->maximum_index() + chunk_size - 1u) / chunk_size;
+			if (bb_chunks_attribute_ != bb_vertex_position_.get() || uint32(bb_chunks_.size()) > nb_chunks)
+			{
+				bb_chunks_.clear();
+				bb_chunks_version_ = 0u;
+			}
+			bb_chunks_attribute_ = bb_vertex_position_.get();
+			// new chunks are modified chunks
+			bb_chunks_.resize(nb_chunks, empty_bb);
+
+			bb_vertex_position_->foreach_modified_range(bb_chunks_version_, [&](uint32 begin, uint32 end) {
+				parallel_foreach_range(
+					begin, end,
+					[&](uint32 b, uint32 e) {
+						for (uint32 c = b / chunk_size; c * chunk_size < e; ++c)
+						{
+							BB bb = empty_bb;
+							for (uint32 i = c * chunk_size, i_end = std::min(e, (c + 1u) * chunk_size); i < i_end;
+								 ++i)
+							{
+								if (!bb_vertex_position_->is_used(i))
+									continue;
+								const Vec3& p = (*bb_vertex_position_)[i];
+								bb.first = bb.first.cwiseMin(p);
+								bb.second = bb.second.cwiseMax(p);
+							}
+							bb_chunks_[c] = bb;
+						}
+					},
+					chunk_size);
+			});
+			bb_chunks_version_ = bb_vertex_position_->version();
+
+			BB bb = empty_bb;
+			for (const BB& cbb : bb_chunks_)
 			{
-				if (p[i] < bb_min_[i])
-					bb_min_[i] = p[i];
-				if (p[i] > bb_max_[i])
-					bb_max_[i] = p[i];
+				bb.first = bb.first.cwiseMin(cbb.first);
+				bb.second = bb.second.cwiseMax(cbb.second);
 			}
+			bb_min_ = bb.first;
+			bb_max_ = bb.second;
+			return;
 		}
+
+		bb_chunks_.clear();
+		bb_chunks_attribute_ = nullptr;
+
+		using Vertex = typename mesh_traits<MESH>::Vertex;
+		BB bb = parallel_transform_reduce_cell(
+			*mesh_, empty_bb, [](BB a, BB b) { return BB(a.first.cwiseMin(b.first), a.second.cwiseMax(b.second)); },
+			[&](Vertex v) {
+				const Vec3& p = value<Vec3>(*mesh_, bb_vertex_position_, v);
+				return BB(p, p);
+			});
+		bb_min_ = bb.first;
+		bb_max_ = bb.second;
 	}
 
 	rendering::VBO* vbo(AttributeGen* attribute)
@@ -187,13 +237,34 @@ public:
 		{
 			const auto [it, inserted] = vbos_.emplace(attribute, std::make_unique<rendering::VBO>());
 			v = it->second.get();
-		}
-		if (v)
 			rendering::update_vbo<T>(attribute, v);
+			vbos_versions_[attribute] = attribute->version();
+		}
+		else if (v)
+		{
+			// only the values modified since the last update are uploaded
+			uint64& version = vbos_versions_[attribute];
+			// nothing was committed since (the attribute was not changed through MeshProvider::emit_attribute_changed):
+			// the marked elements are committed, or, if the writer did not mark anything, all the elements
+			if (attribute->version() == version)
+			{
+				if (!attribute->has_uncommitted_modifications())
+					attribute->mark_all_modified();
+				attribute->commit_modifications();
+			}
+			version = rendering::update_vbo<T>(attribute, v, version);
+		}
 
 		return v;
 	}
 
+	// forget the bounding boxes of the chunks (e.g. when vertices are removed)
+	void reset_bb_chunks()
+	{
+		bb_chunks_.clear();
+		bb_chunks_attribute_ = nullptr;
+	}
+
 	template <typename CELL, typename FUNC>
 	void foreach_cells_set(const FUNC& f)
 	{
@@ -259,7 +330,14 @@ private:
 
 	rendering::MeshRender render_;
 	std::unordered_map<AttributeGen*, std::unique_ptr<rendering::VBO>> vbos_;
+	// version of the attribute each vbo was built from
+	std::unordered_map<AttributeGen*, uint64> vbos_versions_;
 	CellsSets cells_sets_;
+
+	// bounding box of each modification chunk of the indices of bb_vertex_position_
+	std::vector<std::pair<Vec3, Vec3>> bb_chunks_;
+	const AttributeGen* bb_chunks_attribute_ = nullptr;
+	uint64 bb_chunks_version_ = 0u;
 };
 
 } // namespace ui
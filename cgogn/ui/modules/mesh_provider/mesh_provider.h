@@ -29,6 +29,7 @@
 #include <cgogn/ui/modules/mesh_provider/mesh_data.h>
 #include <cgogn/ui/portable-file-dialogs.h>
 
+#include <cgogn/core/types/derived_attribute.h>
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/utils/string.h>
 #include <cgogn/geometry/types/vector_traits.h>
@@ -36,6 +37,7 @@
 #include <cgogn/io/graph/cg.h>
 #include <cgogn/io/graph/cgr.h>
 #include <cgogn/io/graph/skel.h>
+#include <cgogn/io/surface/obj.h>
 #include <cgogn/io/surface/off.h>
 #include <cgogn/io/volume/meshb.h>
 #include <cgogn/io/volume/tet.h>
@@ -186,6 +188,8 @@ public:
 			bool imported;
 			if (ext.compare("off") == 0)
 				imported = cgogn::io::import_OFF(*m, filename);
+			else if (ext.compare("obj") == 0)
+				imported = cgogn::io::import_OBJ(*m, filename);
 			else
 				imported = false;
 
@@ -352,6 +356,11 @@ public:
 	template <typename T>
 	void emit_attribute_changed(const MESH* m, Attribute<T>* attribute)
 	{
+		// writers that did not mark the elements they modified may have modified all of them
+		if (!attribute->has_uncommitted_modifications())
+			attribute->mark_all_modified();
+		attribute->commit_modifications();
+
 		MeshData<MESH>& md = mesh_data_[m];
 		md.update_vbo(attribute);
 		if (static_cast<AttributeGen*>(md.bb_vertex_position_.get()) == static_cast<AttributeGen*>(attribute))
@@ -373,7 +382,10 @@ public:
 	{
 		MeshData<MESH>* md = mesh_data(m);
 		md->update_nb_cells();
+		md->reset_bb_chunks();
 		md->rebuild_cells_sets();
+		if constexpr (std::is_convertible_v<MESH&, CMapBase&>)
+			invalidate_derived_attributes(*m);
 		md->set_all_primitives_dirty();
 
 		for (View* v : linked_views_)
@@ -562,15 +574,98 @@ protected:
 				ImGui::NextColumn();
 			}
 			ImGui::Columns(1);
+
+			if constexpr (std::is_convertible_v<MESH&, CMapBase&>)
+			{
+				ImGui::Separator();
+				if (ImGui::CollapsingHeader("Memory"))
+					memory_interface(static_cast<const CMapBase&>(*selected_mesh_));
+			}
 		}
 	}
 
 private:
+	// name of the cell of the mesh that has the given orbit
+	template <typename... T>
+	static std::string orbit_cell_name(Orbit orbit, const std::tuple<T...>&)
+	{
+		const std::array<Orbit, sizeof...(T)> orbits = {T::ORBIT...};
+		for (uint32 i = 0; i < sizeof...(T); ++i)
+		{
+			if (orbits[i] == orbit)
+				return mesh_traits<MESH>::cell_names[i];
+		}
+		return orbit_name(orbit);
+	}
+
+	// the report is only computed while the section is open
+	void memory_interface(const CMapBase& m)
+	{
+		using ContainerReport = CMapBase::AttributeContainer::MemoryReport;
+
+		CMapBase::MemoryReport report = m.memory_report();
+		ThreadBuffersReport buffers = thread_buffers_report();
+		ImGui::Text("Total: %.2f MB", float64(report.total_bytes()) / (1024.0 * 1024.0));
+		ImGui::Text("Threads buffers: %.2f KB pooled (%d threads, %d buffers in use)",
+					float64(buffers.pooled_bytes) / 1024.0, buffers.nb_threads, buffers.nb_used_buffers);
+		ChunkArenasReport arenas = chunk_arenas_report();
+		if (arenas.nb_arenas > 0u)
+			ImGui::Text("Chunk arenas: %.2f MB (%d arenas, %.2f MB free)",
+						float64(arenas.arenas_bytes) / (1024.0 * 1024.0), arenas.nb_arenas,
+						float64(arenas.free_bytes) / (1024.0 * 1024.0));
+
+		ImGui::Columns(5);
+		ImGui::Separator();
+		ImGui::TextUnformatted("Container");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Elements");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Capacity");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("Holes");
+		ImGui::NextColumn();
+		ImGui::TextUnformatted("MB");
+		ImGui::NextColumn();
+		ImGui::Separator();
+		auto container_row = [](const std::string& name, const ContainerReport& r) {
+			ImGui::TextUnformatted(name.c_str());
+			ImGui::NextColumn();
+			ImGui::Text("%d", r.nb_elements);
+			ImGui::NextColumn();
+			ImGui::Text("%d", r.capacity);
+			ImGui::NextColumn();
+			ImGui::Text("%.1f%%", 100.0 * r.fragmentation());
+			ImGui::NextColumn();
+			ImGui::Text("%.2f", float64(r.total_bytes()) / (1024.0 * 1024.0));
+			ImGui::NextColumn();
+		};
+		container_row("Darts", report.darts);
+		for (const auto& [orbit, r] : report.cells)
+			container_row(orbit_cell_name(orbit, typename mesh_traits<MESH>::Cells{}), r);
+		ImGui::Columns(1);
+		ImGui::Separator();
+
+		auto container_details = [](const std::string& name, const ContainerReport& r) {
+			if (ImGui::TreeNode(name.c_str()))
+			{
+				for (const auto& a : r.attributes)
+					ImGui::Text("%s: %.1f KB", a.name.c_str(), float64(a.bytes) / 1024.0);
+				ImGui::Text("marks: %d (%d available), %.1f KB", r.nb_mark_attributes,
+							r.nb_available_mark_attributes, float64(r.mark_attributes_bytes) / 1024.0);
+				ImGui::Text("bookkeeping: %.1f KB", float64(r.bookkeeping_bytes) / 1024.0);
+				ImGui::TreePop();
+			}
+		};
+		container_details("Darts", report.darts);
+		for (const auto& [orbit, r] : report.cells)
+			container_details(orbit_cell_name(orbit, typename mesh_traits<MESH>::Cells{}), r);
+	}
+
 	std::vector<std::string> supported_graph_formats_ = {"cg", "cgr", "skel"};
 	std::vector<std::string> supported_graph_files_ = {"Graph", "*.cg *.cgr *.skel"};
 
-	std::vector<std::string> supported_surface_formats_ = {"off"};
-	std::vector<std::string> supported_surface_files_ = {"Surface", "*.off"};
+	std::vector<std::string> supported_surface_formats_ = {"off", "obj"};
+	std::vector<std::string> supported_surface_files_ = {"Surface", "*.off *.obj"};
 
 	std::vector<std::string> supported_volume_formats_ = {"tet"};
 	std::vector<std::string> supported_volume_files_ = {"Volume", "*.tet"};
@@ -486,6 +486,7 @@ private:
 			pos[0] = x(vidx, 0);
 			pos[1] = x(vidx, 1);
 			pos[2] = x(vidx, 2);
+			p.vertex_position_->mark_modified(index_of(*m, v));
 			return true;
 		});
 	}
@@ -543,6 +544,14 @@ protected:
 					for (View* v : linked_views_)
 						v->lock_scene_bb();
 
+					// while dragging, the moved vertices are marked so that only they are updated by the consumers
+					// of the position; tracking is only enabled for the drag as the other writers do not mark
+					if (!p.vertex_position_->is_modification_tracked())
+					{
+						p.vertex_position_->enable_modification_tracking();
+						drag_tracked_position_ = p.vertex_position_;
+					}
+
 					dragging_ = true;
 				}
 			}
@@ -558,6 +567,10 @@ protected:
 			{
 				dragging_ = false;
 
+				if (drag_tracked_position_)
+					drag_tracked_position_->disable_modification_tracking();
+				drag_tracked_position_.reset();
+
 				for (View* v : linked_views_)
 					v->unlock_scene_bb();
 			}
@@ -572,8 +585,10 @@ protected:
 
 			rendering::GLVec3d drag_pos = view->unproject(x, y, drag_z_);
 			Vec3 t = drag_pos - previous_drag_pos_;
-			p.selected_handle_vertices_set_->foreach_cell(
-				[&](Vertex v) { value<Vec3>(*selected_mesh_, p.vertex_position_, v) += t; });
+			p.selected_handle_vertices_set_->foreach_cell([&](Vertex v) {
+				value<Vec3>(*selected_mesh_, p.vertex_position_, v) += t;
+				p.vertex_position_->mark_modified(index_of(*selected_mesh_, v));
+			});
 			as_rigid_as_possible(selected_mesh_);
 			previous_drag_pos_ = drag_pos;
 
@@ -660,6 +675,8 @@ private:
 	MeshProvider<MESH>* mesh_provider_;
 
 	bool dragging_;
+	// position whose modification tracking was enabled for the current drag
+	std::shared_ptr<Attribute<Vec3>> drag_tracked_position_;
 	float64 drag_z_;
 	rendering::GLVec3d previous_drag_pos_;
 };
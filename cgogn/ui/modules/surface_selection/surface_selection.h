@@ -33,6 +33,7 @@
 
 #include <cgogn/geometry/algos/picking.h>
 #include <cgogn/geometry/algos/selection.h>
+#include <cgogn/geometry/types/bvh.h>
 #include <cgogn/geometry/types/vector_traits.h>
 
 #include <cgogn/rendering/shaders/shader_bold_line.h>
@@ -124,7 +125,7 @@ class SurfaceSelection : public ViewModule
 				std::vector<Vec3> selected_edges_position;
 				selected_edges_position.reserve(selected_edges_set_->size() * 2);
 				selected_edges_set_->foreach_cell([&](Edge e) {
-					std::vector<Vertex> vertices = incident_vertices(*mesh_, e);
+					CellsSmallVector<Vertex> vertices = incident_vertices(*mesh_, e);
 					selected_edges_position.push_back(value<Vec3>(*mesh_, vertex_position_, vertices[0]));
 					selected_edges_position.push_back(value<Vec3>(*mesh_, vertex_position_, vertices[1]));
 				});
@@ -148,8 +149,17 @@ class SurfaceSelection : public ViewModule
 			}
 		}
 
+		// the BVH is built on the first picking and dropped when the position attribute or the connectivity change
+		const geometry::BVH<MESH>& bvh()
+		{
+			if (!bvh_)
+				bvh_ = std::make_unique<geometry::BVH<MESH>>(*mesh_, vertex_position_);
+			return *bvh_;
+		}
+
 		MESH* mesh_;
 		std::shared_ptr<Attribute<Vec3>> vertex_position_;
+		std::unique_ptr<geometry::BVH<MESH>> bvh_;
 
 		std::unique_ptr<rendering::ShaderPointSprite::Param> param_point_sprite_;
 		std::unique_ptr<rendering::ShaderBoldLine::Param> param_edge_;
@@ -192,6 +202,8 @@ private:
 					Parameters& p = parameters_[m];
 					if (p.vertex_position_.get() == attribute)
 					{
+						if (p.bvh_)
+							p.bvh_->refit();
 						p.vertex_base_size_ = float32(geometry::mean_edge_length(*m, p.vertex_position_.get()) / 6);
 						p.update_selected_vertices_vbo();
 						p.update_selected_edges_vbo();
@@ -201,6 +213,11 @@ private:
 					for (View* v : linked_views_)
 						v->request_update();
 				}));
+		mesh_connections_[m].push_back(
+			boost::synapse::connect<typename MeshProvider<MESH>::connectivity_changed>(m, [this, m]() {
+				Parameters& p = parameters_[m];
+				p.bvh_.reset();
+			}));
 		mesh_connections_[m].push_back(
 			boost::synapse::connect<typename MeshProvider<MESH>::template cells_set_changed<Vertex>>(
 				m, [this, m](CellsSet<MESH, Vertex>* set) {
@@ -242,6 +259,7 @@ public:
 		Parameters& p = parameters_[&m];
 
 		p.vertex_position_ = vertex_position;
+		p.bvh_.reset();
 		if (p.vertex_position_)
 		{
 			p.vertex_base_size_ = float32(geometry::mean_edge_length(m, p.vertex_position_.get()) / 6); // 6 ???
@@ -287,7 +305,7 @@ protected:
 						if (p.selected_vertices_set_)
 						{
 							std::vector<Vertex> picked;
-							cgogn::geometry::picking(*selected_mesh_, p.vertex_position_.get(), A, B, picked);
+							cgogn::geometry::picking(p.bvh(), A, B, picked);
 							if (!picked.empty())
 							{
 								switch (button)
@@ -307,7 +325,7 @@ protected:
 						if (p.selected_edges_set_)
 						{
 							std::vector<Edge> picked;
-							cgogn::geometry::picking(*selected_mesh_, p.vertex_position_.get(), A, B, picked);
+							cgogn::geometry::picking(p.bvh(), A, B, picked);
 							if (!picked.empty())
 							{
 								switch (button)
@@ -327,7 +345,7 @@ protected:
 						if (p.selected_faces_set_)
 						{
 							std::vector<Face> picked;
-							cgogn::geometry::picking(*selected_mesh_, p.vertex_position_.get(), A, B, picked);
+							cgogn::geometry::picking(p.bvh(), A, B, picked);
 							if (!picked.empty())
 							{
 								switch (button)
@@ -348,7 +366,7 @@ protected:
 				}
 				case WithinSphere: {
 					std::vector<Vertex> picked;
-					cgogn::geometry::picking(*selected_mesh_, p.vertex_position_.get(), A, B, picked);
+					cgogn::geometry::picking(p.bvh(), A, B, picked);
 					if (!picked.empty())
 					{
 						CellCache<MESH> cache = geometry::within_sphere(*selected_mesh_, picked[0],